@@ -30,97 +30,365 @@
  */
 
 
-#include "mbed.h"
+#include <string.h>
+
 #include "SI7050.h"
 
-SI7050::SI7050(PinName sda, PinName scl, char slave_adr)
+SI7050Device::SI7050Device(SI7050Bus &bus_obj, char slave_adr)
         :
-        i2c_p(new I2C(sda, scl)),
-        i2c(*i2c_p),
-        address(slave_adr),
-        ret(0) {
-    /* nothing to do */
+        bus(bus_obj),
+#ifdef SI70_STATS
+        statsBus(bus),
+        core(statsBus, slave_adr),
+#else
+        core(bus, slave_adr),
+#endif
+        resolution(resolutionFromBits(SI70_RESOLUTION)),
+        measuring(false),
+        measStart(0),
+        measCallback(NULL),
+        measContext(NULL),
+        measRetries(0),
+        integrityMode(SI70_INTEGRITY_NONE),
+        completionMode(SI70_COMPLETION_SLEEP),
+        pollInterval(SI70_POLL_INTERVAL_US),
+        retryPolicy(),
+        recoveryStats(),
+        descriptor(),
+        shadowValid(false),
+        skippedTransactions(0) {
+#ifdef SI70_STATS
+    clearStats();
+#endif
 }
 
-
-SI7050::SI7050(I2C &i2c_obj, char slave_adr)
-        :
-        i2c_p(NULL),
-        i2c(i2c_obj),
-        address(slave_adr),
-        ret(0) {
+SI7050Device::~SI7050Device() {
     /* nothing to do */
 }
 
-SI7050::~SI7050() {
-    delete i2c_p;
+int SI7050Device::reset() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    statsBegin(SI70_OP_RESET);
+    int ret = core.reset();
+
+    // the reset restores the default of the user register
+    shadowValid = false;
+
+    if (ret) {
+        statsError(ERROR_RESET);
+    }
+    statsEnd(SI70_OP_RESET, ret);
+
+    return ret;
 }
 
-int SI7050::reset() {
-    char cmd[1];
+int SI7050Device::initialize() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    statsBegin(SI70_OP_CONFIG);
+    int ret = withRetries([this]() {
+        int ret_ = writeResolution((char) resolutionToBits(resolution));
 
-    cmd[0] = static_cast<char>(SI70_RESET); // RESET
-    ret = i2c.write(address, cmd, 1, false);
+        // read the identity of the sensor only once
+        if (!ret_ && !descriptor.valid) {
+            ret_ = readDescriptor();
+        }
+        return ret_;
+    });
+    statsEnd(SI70_OP_CONFIG, ret);
 
     return ret;
 }
 
-int SI7050::initialize() {
-    char cmd[2];
+int SI7050Device::writeResolution(char resBits) {
+    char value;
     char temp;
-
-    cmd[0] = static_cast<char>(SI70_READ_UR); // read user register
-    ret = i2c.write(address, cmd, 1, true);
-    ret |= i2c.read(address, &cmd[1], 1, false);
+    int ret;
+
+    // read-modify-write of the register, nobody else may access it in between
+    SI7050ScopedLock<SI7050Bus> busLock(bus);
+
+    // read the user register only, if the shadow copy is stale
+    if (shadowValid) {
+        value = descriptor.userRegister;
+        skippedTransactions += 2;
+    } else {
+        ret = readUserRegister(&value);
+        if (ret) {
+            return ret;
+        }
+    }
 
     // set the new resolution, without changeing the other bits in the register 
-    temp = (char) ((cmd[1] & ~SI70_RES_MASK) | SI70_RESOLUTION);
+    temp = (char) ((value & ~SI70_RES_MASK) | (resBits & SI70_RES_MASK));
+    if (shadowValid && temp == descriptor.userRegister) {
+        skippedTransactions++;
+        return 0;
+    }
 
-    cmd[0] = static_cast<char>(SI70_WRITE_UR); // write user register
-    cmd[1] = temp;
-    ret |= i2c.write(address, cmd, 2, false);
+    ret = core.writeUserRegister(temp);
+    if (!ret) {
+        descriptor.userRegister = temp;
+    } else {
+        statsError(ERROR_INIT_WRITE_BACK);
+    }
+    shadowValid = (ret == 0);
 
     return ret;
 }
 
-int SI7050::measureTemperature(char *data) {
-    int ret_ = -1;
-    char cmd[1];
+int SI7050Device::setResolution(int bits) {
+    int resBits = resolutionToBits(bits);
+
+    if (resBits < 0) {
+        return -1;
+    }
+
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    statsBegin(SI70_OP_CONFIG);
+    int ret = withRetries([this, resBits]() { return writeResolution((char) resBits); });
+    if (!ret) {
+        resolution = bits;
+    }
+    statsEnd(SI70_OP_CONFIG, ret);
+
+    return ret;
+}
+
+int SI7050Device::getResolution() const {
+    return resolution;
+}
+
+uint32_t SI7050Device::getConversionTime() const {
+    return Si705xResolutions::fromBits(resolution).conversionUs;
+}
+
+uint16_t SI7050Device::getRawMask() const {
+    return Si705xResolutions::fromBits(resolution).mask;
+}
+
+int SI7050Device::resolutionFromBits(char resBits) {
+    return Si705xResolutions::fromUserRegister(resBits).bits;
+}
+
+int SI7050Device::resolutionToBits(int bits) {
+    if (!Si705xResolutions::supported(bits)) {
+        return -1;
+    }
+    return (unsigned char) Si705xResolutions::fromBits(bits).userRegister;
+}
+
+int SI7050Device::measureTemperature(char *data) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
 
     // check the length of the data buffer and if pointer is set correct  
     if (data == NULL) {
-        return ret_;
+        return -1;
     }
 
-    cmd[0] = static_cast<char>(SI70_MEASURE); // measure temperature
-    ret = i2c.write(address, cmd, 1, false); // WG last 0 was a 1
-    // WG small delay
-    wait_ms(11);
+    return withRetries([this, data]() { return measureOnce(data); });
+}
 
-    ret |= i2c.read(address, data, 2, false);
+int SI7050Device::measureOnce(char *data) {
+    int ret_ = -1;
 
-    if (ret) {
+    if (completionMode == SI70_COMPLETION_HOLD) {
+        return measureHold(data);
+    }
+
+    if (startMeasurement()) {
         return (ret_);
     }
 
+    // wait for the conversion of the selected resolution or poll until the
+    // sensor acknowledges, a failed CRC check restarts the conversion
+    do {
+        bus.waitUs(completionMode == SI70_COMPLETION_POLL ? pollInterval : getConversionTime());
+        ret_ = pollResult(data);
+    } while (ret_ == SI70_NOT_READY);
+
+    return ret_;
+}
+
+int SI7050Device::measureHold(char *data) {
+    char buffer[3];
+    int length = (integrityMode == SI70_INTEGRITY_CRC) ? 3 : 2;
+
+    measCallback = NULL;
+    measContext = NULL;
+    statsBegin(SI70_OP_MEASURE);
+    for (measRetries = 0;; measRetries++) {
+        if (core.measureHold(buffer, length)) {
+            statsError(ERROR_MEAS_READ);
+            return finishMeasurement(-1, NULL);
+        }
+        if (integrityMode != SI70_INTEGRITY_CRC || SI7050Crc::check((const unsigned char *) buffer)) {
+            break;
+        }
+        if (measRetries >= SI70_CRC_RETRIES) {
+            statsError(ERROR_MEAS_CRC);
+            return finishMeasurement(SI70_ERROR_CRC, NULL);
+        }
+        statsRetry(true);
+    }
+
+    data[0] = buffer[0];
+    data[1] = buffer[1];
+
+    return finishMeasurement(0, buffer);
+}
+
+int SI7050Device::measureSample(SI7050Sample *sample) {
+    char data[2];
+    int ret_ = measureTemperature(data);
+
+    sample->timestamp = bus.readUs();
+    sample->raw = 0;
+    switch (ret_) {
+        case 0:
+            sample->raw = (uint16_t) (((unsigned char) data[0] << 8) | (unsigned char) data[1]);
+            sample->status = SI70_SAMPLE_OK;
+            break;
+        case SI70_ERROR_CRC:
+            sample->status = SI70_SAMPLE_CRC;
+            break;
+        default:
+            sample->status = SI70_SAMPLE_ERROR;
+            break;
+    }
+
+    return ret_;
+}
+
+int SI7050Device::startMeasurement() {
+    return startMeasurement(NULL, NULL);
+}
+
+int SI7050Device::startMeasurement(SI7050Callback callback, void *context) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+
+    measCallback = callback;
+    measContext = context;
+    measRetries = 0;
+    statsBegin(SI70_OP_MEASURE);
+
+    if (sendMeasure()) {
+        statsEnd(SI70_OP_MEASURE, -1);
+        return -1;
+    }
+    return 0;
+}
+
+int SI7050Device::sendMeasure() {
+    int ret = core.startMeasurement();
+    if (ret) {
+        measuring = false;
+        statsError(ERROR_MEAS_START);
+        return -1;
+    }
+
+    measuring = true;
+    measStart = bus.readUs();
+
+    return 0;
+}
+
+int SI7050Device::pollResult(char *data) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    char buffer[3];
+    int length = (integrityMode == SI70_INTEGRITY_CRC) ? 3 : 2;
+
+    if (!measuring) {
+        return -1;
+    }
+
+    // the sensor does not acknowledge the read, until the conversion is done
+    int ret = core.readMeasurement(buffer, length);
+    if (ret) {
+        // give up polling after twice the conversion time
+        if ((uint32_t) (bus.readUs() - measStart) < 2 * getConversionTime()) {
+            statsRetry(false);
+            return SI70_NOT_READY;
+        }
+        statsError(ERROR_MEAS_READ);
+        return finishMeasurement(-1, NULL);
+    }
+
+    if (integrityMode == SI70_INTEGRITY_CRC && !SI7050Crc::check((const unsigned char *) buffer)) {
+        // measure again, as the sensor does not repeat the result
+        if (measRetries < SI70_CRC_RETRIES) {
+            measRetries++;
+            statsRetry(true);
+            if (sendMeasure() == 0) {
+                return SI70_NOT_READY;
+            }
+            return finishMeasurement(-1, NULL);
+        }
+        statsError(ERROR_MEAS_CRC);
+        return finishMeasurement(SI70_ERROR_CRC, NULL);
+    }
+
+    if (data != NULL) {
+        data[0] = buffer[0];
+        data[1] = buffer[1];
+    }
+
+    return finishMeasurement(0, buffer);
+}
+
+int SI7050Device::finishMeasurement(int status, const char *data) {
+    measuring = false;
+    statsEnd(SI70_OP_MEASURE, status);
+    if (status == 0) {
+        latest.publish(bus.readUs(), (uint16_t) (((unsigned char) data[0] << 8) | (unsigned char) data[1]));
+    }
+    if (measCallback != NULL) {
+        measCallback(measContext, status, data);
+    }
+
+    return status;
+}
+
+void SI7050Device::setIntegrityMode(int mode) {
+    integrityMode = mode;
+}
+
+int SI7050Device::getIntegrityMode() const {
+    return integrityMode;
+}
+
+int SI7050Device::setCompletionMode(int mode, uint32_t pollIntervalUs) {
+    if (mode != SI70_COMPLETION_SLEEP && mode != SI70_COMPLETION_POLL && mode != SI70_COMPLETION_HOLD) {
+        return -1;
+    }
+
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    completionMode = mode;
+    pollInterval = pollIntervalUs;
+
     return 0;
 }
 
-int SI7050::calcTemperature(const char *data) {
-    uint32_t temp_raw = 0;
-    int32_t temp_c;
+int SI7050Device::getCompletionMode() const {
+    return completionMode;
+}
 
-    temp_raw = static_cast<uint32_t>((data[0] << 8) | (data[1]));
-    temp_c = ((17572 * (temp_raw)) >> 16) - 4685;
+bool SI7050Device::isMeasuring() const {
+    return measuring;
+}
+
+int SI7050Device::calcTemperature(const char *data) {
+    uint16_t temp_raw;
+
+    temp_raw = (uint16_t) (((unsigned char) data[0] << 8) | (unsigned char) data[1]);
 
-    return (int) (temp_c);
+    return Si705xCentiCelsius::fromRaw((uint16_t) (temp_raw & getRawMask()));  // mask the unused bits
 }
 
-int SI7050::getTemperature() {
+int SI7050Device::getTemperature() {
     int ret_ = -32768;
     char data[2];
 
-    ret = measureTemperature(data);
+    int ret = measureTemperature(data);
     if (ret) {
         return (ret_);
     }
@@ -129,131 +397,275 @@ int SI7050::getTemperature() {
     return (ret);
 }
 
-int SI7050::getFirmwareVersion() {
-    char cmd[2];
-    char data[1];
-    int ret_ = -1;
+int SI7050Device::getTemperature(uint32_t maxAgeUs) {
+    uint16_t raw;
 
+    if (readLatest(maxAgeUs, &raw)) {
+        return Si705xCentiCelsius::fromRaw((uint16_t) (raw & getRawMask()));
+    }
 
-    cmd[0] = static_cast<char>(SI70_READ_FW_1);
-    cmd[1] = static_cast<char>(SI70_READ_FW_2);
+    // another reader may have measured, while we waited for the lock
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    if (readLatest(maxAgeUs, &raw)) {
+        return Si705xCentiCelsius::fromRaw((uint16_t) (raw & getRawMask()));
+    }
 
-    ret = i2c.write(address, cmd, 2, false);
-    ret |= i2c.read(address, data, 1, false);
-    if (ret) {
-        return ret_;
+    return getTemperature();
+}
+
+bool SI7050Device::readLatest(uint32_t maxAgeUs, uint16_t *raw) const {
+    uint32_t timestamp;
+
+    if (!latest.read(&timestamp, raw)) {
+        return false;
     }
+    return (uint32_t) (bus.readUs() - timestamp) <= maxAgeUs;
+}
 
-    ret_ = (int) (data[0]);
+int SI7050Device::getLatestSample(SI7050Sample *sample) const {
+    if (!latest.read(&sample->timestamp, &sample->raw)) {
+        return -1;
+    }
+    sample->status = SI70_SAMPLE_OK;
 
-    return ret_;
+    return 0;
+}
+
+int SI7050Device::getFirmwareVersion() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    if (descriptor.valid) {
+        return descriptor.firmware;
+    }
+
+    statsBegin(SI70_OP_IDENT);
+    int firmware = readFirmwareVersion();
+    statsEnd(SI70_OP_IDENT, firmware < 0);
+
+    return firmware;
 }
 
-int SI7050::getID() {
+int SI7050Device::readFirmwareVersion() {
+    int firmware = core.readFirmwareVersion();
+
+    if (firmware < 0) {
+        statsError(ERROR_IDENT);
+    }
+    return firmware;
+}
+
+int SI7050Device::getID() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    if (descriptor.valid) {
+        return descriptor.id;
+    }
+
     unsigned char serial[16];
     int ret = getSerial(serial);
     if(!ret) return serial[4];
     return ret;
 }
 
-int SI7050::getSerial(unsigned char serial[8]) {
-    char cmd[4];
-    char data[16];
-
-    // first access for the first 4 Bytes
-    cmd[0] = static_cast<char>(SI70_READ_ID_11);
-    cmd[1] = static_cast<char>(SI70_READ_ID_12);
+int SI7050Device::getSerial(unsigned char serial[8]) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    if (descriptor.valid) {
+        memcpy(serial, descriptor.serial, sizeof(descriptor.serial));
+        return 0;
+    }
 
-    ret = i2c.write(address, cmd, 2, true);
-    ret |= i2c.read(address, data, 8, false);
-    if (ret) return -1;
+    statsBegin(SI70_OP_IDENT);
+    int ret = readSerial(serial);
+    statsEnd(SI70_OP_IDENT, ret);
 
-    serial[0] = (unsigned char) data[0];
-    serial[1] = (unsigned char) data[2];
-    serial[2] = (unsigned char) data[4];
-    serial[3] = (unsigned char) data[6];
+    return ret;
+}
 
-    // second access for the last 4 Bytes
-    cmd[2] = static_cast<char>(SI70_READ_ID_21);
-    cmd[3] = static_cast<char>(SI70_READ_ID_22);
+int SI7050Device::readSerial(unsigned char serial[8]) {
+    char data[16];
 
-    ret = i2c.write(address, &cmd[2], 2, true);
-    ret |= i2c.read(address, &data[8], 8, false);
-    if (ret) return -1;
+    // two accesses for the first and the last 4 Bytes
+    if (core.readSerialRaw(data)) {
+        statsError(ERROR_IDENT);
+        return -1;
+    }
 
-    serial[4] = (unsigned char) data[8];
-    serial[5] = (unsigned char) data[9];
-    serial[6] = (unsigned char) data[11];
-    serial[7] = (unsigned char) data[12];
+    Si705xSerial::decode(data, serial);
 
     /*
      * check the CRC of the serial number
      */
-//    if(!checkSerial((unsigned char*)(data)))
-//        return -1;
+    if(!checkSerial((unsigned char*)(data))) {
+        statsError(ERROR_IDENT);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int SI7050Device::readUserRegister(char *value) {
+    int ret = core.readUserRegister(value);
+    if (!ret) {
+        descriptor.userRegister = *value;
+    } else {
+        // the command or the read of the register failed
+        statsError(ret < 0 ? ERROR_INIT_WRITE : ERROR_INIT_READ);
+        ret = -1;
+    }
+    shadowValid = (ret == 0);
 
     return ret;
 }
 
+int SI7050Device::refreshDescriptor() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
 
-bool SI7050::checkSerial(unsigned char *serialRaw){
-    unsigned char crc;
+    return withRetries([this]() { return readDescriptor(); });
+}
 
-    crc = crc8(&serialRaw[0],1,0);
-    if(crc != serialRaw[1])
-        return false;
+int SI7050Device::readDescriptor() {
+    int firmware;
+    char userRegister;
 
-    for (int i = 2; i < 8 ;) {
-        crc = crc8(&serialRaw[i],1, serialRaw[i-1]);
-        if(serialRaw[i+1] != crc)
-            return false;
-        i+=2;
+    descriptor.valid = false;
+    statsBegin(SI70_OP_IDENT);
+
+    if (readSerial(descriptor.serial)) {
+        statsEnd(SI70_OP_IDENT, -1);
+        return -1;
+    }
+    firmware = readFirmwareVersion();
+    if (firmware < 0) {
+        statsEnd(SI70_OP_IDENT, -1);
+        return -1;
+    }
+    if (readUserRegister(&userRegister)) {
+        statsEnd(SI70_OP_IDENT, -1);
+        return -1;
     }
 
-    crc = crc8(&serialRaw[8],2,0);
-    if(serialRaw[10] != crc)
-        return false;
+    descriptor.id = descriptor.serial[4];
+    descriptor.firmware = firmware;
+    descriptor.valid = true;
+    statsEnd(SI70_OP_IDENT, 0);
 
-    for (int i = 11; i < 13 ;) {
+    return 0;
+}
 
-        crc = crc8(&serialRaw[i],2, serialRaw[i-1]);
-        if(serialRaw[i+2] != crc)
-            return false;
-        i+=3;
-    }
+const SI7050Descriptor &SI7050Device::getDescriptor() const {
+    return descriptor;
+}
 
-    return true;
+SI7050Bus &SI7050Device::getBus() {
+    return bus;
 }
 
-unsigned char SI7050::crc8(unsigned char *data, uint8_t len, unsigned char init){
-    unsigned char crc = bitswap(init);
+void SI7050Device::lock() {
+    mutex.lock();
+}
 
-    for (int i=0; i<len;i++)
-    {
-        unsigned char inbyte = bitswap(data[i]);
-        for (uint8_t j=0;j<8;j++)
-        {
-            unsigned char mix = (crc ^ inbyte) & 0x01;
-            crc >>= 1;
-            if (mix)
-                crc ^= 0x8C;
+void SI7050Device::unlock() {
+    mutex.unlock();
+}
+
+void SI7050Device::invalidateShadow() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    shadowValid = false;
+}
+
+uint32_t SI7050Device::getSkippedTransactions() const {
+    return skippedTransactions;
+}
 
-            inbyte >>= 1;
+void SI7050Device::setRetryPolicy(const SI7050RetryPolicy &policy) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    retryPolicy = policy;
+}
+
+const SI7050RetryPolicy &SI7050Device::getRetryPolicy() const {
+    return retryPolicy;
+}
+
+const SI7050RecoveryStats &SI7050Device::getRecoveryStats() const {
+    return recoveryStats;
+}
+
+template<typename F>
+int SI7050Device::withRetries(F operation) {
+    uint32_t start = bus.readUs();
+    uint32_t backoff = retryPolicy.backoffUs;
+    int ret = operation();
+    // the next attempt is expected to take as long as the longest one so far
+    uint32_t attempt = bus.readUs() - start;
+
+    // a CRC error is not a bus fault, the integrity mode retries it
+    for (int retry = 1; ret != 0 && ret != SI70_ERROR_CRC && retry <= retryPolicy.retries; retry++) {
+        bool reset = (retry == 3 && retryPolicy.softReset);
+        uint64_t end = (uint64_t) (bus.readUs() - start) + backoff + attempt + (reset ? SI70_RESET_TIME_US : 0);
+
+        if (retryPolicy.deadlineUs && end > retryPolicy.deadlineUs) {
+            recoveryStats.deadlines++;
+            break;
+        }
+
+        bus.waitUs(backoff);
+        // maxBackoffUs 0: no upper limit
+        if (backoff <= UINT32_MAX / 2) {
+            backoff *= 2;
+        }
+        if (retryPolicy.maxBackoffUs && backoff > retryPolicy.maxBackoffUs) {
+            backoff = retryPolicy.maxBackoffUs;
+        }
+
+        if (retry == 2 && retryPolicy.busRecovery) {
+            recoveryStats.busRecoveries++;
+            bus.recover();
+        }
+        if (reset) {
+            recoveryStats.softResets++;
+            softReset();
+        }
+
+        recoveryStats.retries++;
+        uint32_t attemptStart = bus.readUs();
+        ret = operation();
+        if (bus.readUs() - attemptStart > attempt) {
+            attempt = bus.readUs() - attemptStart;
+        }
+        if (ret == 0) {
+            recoveryStats.recovered++;
         }
     }
-    return bitswap(crc);
-}
 
-unsigned char SI7050::bitswap(unsigned char input){
-    unsigned char output = 0;
-    for (int k = 0; k < 8; k++) {
-        output |= ((input >> k) & 0x01) << (7 - k);
+    if (ret != 0) {
+        recoveryStats.failures++;
     }
-    return output;
+    return ret;
 }
 
+int SI7050Device::softReset() {
+    if (core.reset()) {
+        statsError(ERROR_RESET);
+        return -1;
+    }
 
+    // the reset restores the default of the user register
+    shadowValid = false;
+    bus.waitUs(SI70_RESET_TIME_US);
 
+    return writeResolution((char) resolutionToBits(resolution));
+}
 
+#ifdef SI70_STATS
+const SI7050Stats &SI7050Device::getStats() const {
+    return stats;
+}
 
+void SI7050Device::clearStats() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    memset(&stats, 0, sizeof(stats));
+}
+#endif
 
+bool SI7050Device::checkSerial(unsigned char *serialRaw){
+    return Si705xSerial::check(serialRaw);
+}
@@ -32,24 +32,14 @@
 #ifndef MBED_SI7050_H
 #define MBED_SI7050_H
 
-#include "mbed.h"
-
-// sensor commands
-#define SI70_ADDRESS    (0x40 << 1)
-#define SI70_MEASURE    0xF3    // WG was E3 before// measure temperature, hold master mode
-#define SI70_RESET      0xFE    // reset
-#define SI70_WRITE_UR   0xE6    // write user register 1
-#define SI70_READ_UR    0xE7    // read user register 1
-#define SI70_READ_FW_1  0x84    // read the firmware version (first command)
-#define SI70_READ_FW_2  0xB8    // read the firmware version (second command)
-#define SI70_READ_ID_11 0xFA    // read the electronic ID (first Byte, first command)
-#define SI70_READ_ID_12 0x0F    // read the electronic ID (first Byte, second command)
-#define SI70_READ_ID_21 0xFC    // read the electronic ID (second Byte, first command)
-#define SI70_READ_ID_22 0xC9    // read the electronic ID (second Byte, second command)
+#include "Si705x.h"
+#include "SI7050Stats.h"
 
+#ifdef __MBED__
+#include <new>
+#endif
 
 // resolution settings
-#define SI70_RES_MASK   0x81
 #define SI70_RESOLUTION 0x00    // 0x00 = resolution is 14 bit
                                 // 0x80 = resolution is 13 bit
                                 // 0x01 = resolution is 12 bit
@@ -62,7 +52,86 @@
 #define ERROR_INIT_WRITE_BACK   (0x0001 << 3) //(8)error during init write back user register
 #define ERROR_MEAS_START        (0x0001 << 4) //(16,10h)error during measurement start 
 #define ERROR_MEAS_READ         (0x0001 << 5) //(32,20h)error during measurement read
+#define ERROR_MEAS_CRC          (0x0001 << 6) //(64,40h)CRC mismatch of the measurement after all retries
+#define ERROR_IDENT             (0x0001 << 7) //(128,80h)error during serial or firmware version read
 
+// return value of pollResult(), if the conversion is still running
+#define SI70_NOT_READY          1
+
+// integrity modes of the measurement
+#define SI70_INTEGRITY_NONE     0       // read 2 Bytes, no check
+#define SI70_INTEGRITY_CRC      1       // read 2 Bytes and the CRC, measure again on mismatch
+#define SI70_CRC_RETRIES        2       // number of measurements repeated on CRC mismatch
+#define SI70_ERROR_CRC          (-2)    // return value if the CRC did not match after all retries
+
+// completion strategies of measureTemperature()
+#define SI70_COMPLETION_SLEEP   0       // wait the maximum conversion time, then read
+#define SI70_COMPLETION_POLL    1       // read until the sensor acknowledges
+#define SI70_COMPLETION_HOLD    2       // hold master mode, the sensor stretches the clock
+#define SI70_POLL_INTERVAL_US   500     // default interval of SI70_COMPLETION_POLL
+
+/** Completion callback of a split-phase measurement
+ *
+ * @param context   user context, which was given to startMeasurement()
+ * @param status    (0) if the measurement was successful, (-1) if error,
+ *                  (SI70_ERROR_CRC) if the CRC did not match
+ * @param data      raw sensor temperature data (2 Bytes), only valid if status is (0)
+ */
+typedef void (*SI7050Callback)(void *context, int status, const char *data);
+
+
+// sample status
+#define SI70_SAMPLE_OK      0   // valid raw data
+#define SI70_SAMPLE_ERROR   1   // bus error or timeout, raw data invalid
+#define SI70_SAMPLE_CRC     2   // CRC error, raw data invalid
+
+/** Timestamped raw sample of the sensor, see measureSample() */
+struct SI7050Sample {
+    uint32_t    timestamp;  // time base of the bus in us
+    uint16_t    raw;        // raw 16 bit temperature code
+    uint8_t     status;     // SI70_SAMPLE_xxx
+};
+
+/** Descriptor of the sensor
+ *
+ *  Identity and configuration of the sensor, which is read once by
+ *  SI7050::initialize() and served from RAM afterwards.
+ */
+struct SI7050Descriptor {
+    unsigned char   serial[8];      // electronic ID
+    int             id;             // sensor type (serial[4]), e.g. 50 = 0x32 = Si7050
+    int             firmware;       // firmware version
+    char            userRegister;   // shadow copy of user register 1
+    bool            valid;          // true if the descriptor was read from the sensor
+};
+
+/** Retry and recovery policy, see SI7050::setRetryPolicy()
+ *
+ *  A failed call is retried up to `retries` times. Before each retry, the
+ *  driver waits the backoff (doubled for every retry) and escalates: the
+ *  first retry only waits, the second one clocks out the bus (busRecovery),
+ *  the third one resets the sensor and writes the configuration again
+ *  (softReset). No retry is started, which would end after the deadline,
+ *  as estimated from the longest attempt of the call so far.
+ */
+struct SI7050RetryPolicy {
+    int         retries;        // number of retries, 0 = fail at once (default)
+    uint32_t    backoffUs;      // wait before the first retry
+    uint32_t    maxBackoffUs;   // upper limit of the doubled backoff, 0 = none
+    bool        busRecovery;    // clock out the bus before the second retry
+    bool        softReset;      // reset the sensor before the third retry
+    uint32_t    deadlineUs;     // time limit of a call including the retries, 0 = none
+};
+
+/** Counters of the retry policy, see SI7050::getRecoveryStats() */
+struct SI7050RecoveryStats {
+    uint32_t    retries;        // retries of failed calls
+    uint32_t    busRecoveries;  // bus clock-out sequences
+    uint32_t    softResets;     // sensor resets
+    uint32_t    deadlines;      // calls, whose retries were stopped by the deadline
+    uint32_t    recovered;      // calls, which succeeded after a retry
+    uint32_t    failures;       // calls, which failed after all retries
+};
 
 /**  Interface for controlling SI7050 Sensor
  *
@@ -87,37 +156,39 @@
  * @endcode
  */
 
-/** SI7050 class
+/** SI7050Device class
  *
- *  SI7050: A library to control, measure and calculate the SI7050 temperature sensor device
+ *  SI7050Device: A library to control, measure and calculate the SI7050 temperature sensor device
+ *
+ *  The transfers and constants are shared with the compile-time specialized
+ *  Si705x template, this class adds the runtime configuration.
+ *
+ *  All functions can be called from several threads, the instance and
+ *  the bus are locked for each operation. The bus is not locked while
+ *  waiting for the conversion, so other sensors on the bus can be used.
+ *
+ *  The device works on a caller provided bus and carries no bus storage,
+ *  SI7050 adds the construction on pins or an I2C object.
  *
  */ 
-class SI7050
+class SI7050Device
 {
 public:
 
     /** Create a SI7050 instance
-     *  which is connected to specified I2C pins with specified address
+     *  which is connected to the specified bus with specified address
      *
-     * @param sda I2C-bus SDA pin
-     * @param scl I2C-bus SCL pin
+     * @param bus_obj bus object (instance), e.g. a simulated bus
      * @param slave_adr (option) I2C-bus address (default: 0x40)
      */
-    SI7050(PinName sda, PinName sck, char slave_adr = (char) SI70_ADDRESS);
+    explicit SI7050Device(SI7050Bus &bus_obj, char slave_adr = (char) SI70_ADDRESS);
 
 
-    /** Create a SI7050 instance
-     *  which is connected to specified I2C pins with specified address
+    /** Destructor of SI7050Device
      *
-     * @param i2c_obj I2C object (instance)
-     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     *  @note       not virtual, the class has no vtable
      */
-    explicit SI7050(I2C &i2c_obj, char slave_adr = (char) SI70_ADDRESS);
-
-
-    /** Destructor of SI7050
-     */
-    virtual ~SI7050();
+    ~SI7050Device();
 
 
     /** Reset SI7050 sensor
@@ -126,19 +197,58 @@ public:
      * 
      *  @note       after resetting the sensor, a minimum time of 15 ms has to
      *              be waited, before the sensor will communicate again
+     *  @note       the shadow copy of the user register is stale after reset
      */
     int reset();
 
 
     /** Initialize SI7050 sensor
      *
-     *  Initialization with 14 bit resolution for temperature measurement
+     *  Initialization with the selected resolution for temperature measurement
+     *  (default 14 bit, see SI70_RESOLUTION and setResolution())
+     *  On the first call, the descriptor of the sensor (serial, ID, firmware)
+     *  is read, see refreshDescriptor().
+     *  The user register is only read and written, if its shadow copy is
+     *  stale or differs from the configuration.
      *
      *  @return         (0) if no error, none (0) if error
      */
     int initialize();
 
 
+    /** Set the resolution of the temperature measurement
+     *
+     *  write the resolution into the user register of the sensor. The
+     *  conversion time and the calculation are adapted to the resolution.
+     *
+     *  @param  bits    resolution in bits (11, 12, 13 or 14)
+     *  @return         (0) if no error, (-1) if the resolution is not
+     *                  supported, none (0) if bus error
+     */
+    int setResolution(int bits);
+
+
+    /** Get the selected resolution of the temperature measurement
+     *
+     *  @return         resolution in bits (11, 12, 13 or 14)
+     */
+    int getResolution() const;
+
+
+    /** Get the conversion time for the selected resolution
+     *
+     *  @return         maximum conversion time in us
+     */
+    uint32_t getConversionTime() const;
+
+
+    /** Get the mask of the used raw data bits for the selected resolution
+     *
+     *  @return         raw data mask (SI70_MASK_xxBIT)
+     */
+    uint16_t getRawMask() const;
+
+
     /** Get the current temperature value from SI7050 sensor
      *
      *  read the measured temperature value from the sensor and 
@@ -150,9 +260,36 @@ public:
     int getTemperature();
 
 
+    /** Get the temperature, served from the latest sample if it is fresh
+     *
+     *  concurrent readers share one measurement: the latest sample is
+     *  read without lock, only if it is older than maxAgeUs, a new
+     *  measurement is done. Readers, which waited for this measurement,
+     *  take its result.
+     *
+     *  @param  maxAgeUs    maximum age of the latest sample in us
+     *  @return             temperature value in 0.01°C resolution, or
+     *                      (-32768) if error
+     */
+    int getTemperature(uint32_t maxAgeUs);
+
+
+    /** Get the latest successful sample of the sensor
+     *
+     *  lock free, can be called from any thread while another thread
+     *  measures
+     *
+     *  @param  sample  storage for the sample
+     *  @return         (0) if a sample is available, (-1) if no
+     *                  measurement was successful yet
+     */
+    int getLatestSample(SI7050Sample *sample) const;
+
+
     /** Calculate the Temperature value from the raw sensor data
      *
-     *  take the raw sensor data and calculate the temperature
+     *  take the raw sensor data and calculate the temperature,
+     *  the bits below the selected resolution are ignored
      *  
      *  @param  data    raw sensor temperature data
      *  @return         temperature value in 0.01°C resolution 
@@ -166,13 +303,118 @@ public:
      *  write the raw data into the data array
      *  
      *  @return         (0) if measurement works, or
-     *                  (-1) if error 
+     *                  (-1) if error, or
+     *                  (SI70_ERROR_CRC) if the CRC check failed (see setIntegrityMode())
      */
     int measureTemperature(char *data);
 
 
+    /** Measure the temperature and store it as timestamped raw sample
+     *
+     *  @param  sample  storage for the sample, the timestamp is the time
+     *                  base of the bus at the end of the measurement
+     *  @return         (0) if measurement works, or
+     *                  (-1) if error, or
+     *                  (SI70_ERROR_CRC) if the CRC check failed
+     */
+    int measureSample(SI7050Sample *sample);
+
+
+    /** Start a temperature measurement without waiting for the result
+     *
+     *  send the measure command (no hold master mode) to the sensor and
+     *  return immediately. The result has to be collected with pollResult().
+     *
+     *  @return         (0) if the measurement was started, or
+     *                  (-1) if error
+     */
+    int startMeasurement();
+
+
+    /** Start a temperature measurement with a completion callback
+     *
+     *  same as startMeasurement(), but the callback is invoked from
+     *  pollResult(), as soon as the measurement is finished or failed.
+     *
+     *  @param  callback    function to call on completion
+     *  @param  context     user context, which is handed to the callback
+     *  @return             (0) if the measurement was started, or
+     *                      (-1) if error
+     */
+    int startMeasurement(SI7050Callback callback, void *context = NULL);
+
+
+    /** Poll the result of a measurement started with startMeasurement()
+     *
+     *  try to read the raw data from the sensor. As long as the conversion
+     *  is running, the sensor does not acknowledge the read and
+     *  SI70_NOT_READY is returned.
+     *
+     *  @param  data    storage for the raw data (2 Bytes), may be NULL
+     *                  if the result is delivered through the callback
+     *  @return         (0) if the measurement is finished, or
+     *                  (SI70_NOT_READY) if the conversion is still running, or
+     *                  (-1) if error or timeout, or
+     *                  (SI70_ERROR_CRC) if the CRC check failed
+     *
+     *  @note       with SI70_INTEGRITY_CRC, a measurement with wrong CRC is
+     *              started again and SI70_NOT_READY is returned, until
+     *              SI70_CRC_RETRIES measurements failed
+     */
+    int pollResult(char *data = NULL);
+
+
+    /** Select the integrity check of the measurement
+     *
+     *  with SI70_INTEGRITY_CRC, the CRC Byte of the sensor is read with
+     *  the measurement and checked, corrupted data is measured again
+     *
+     *  @param  mode    SI70_INTEGRITY_NONE (default) or SI70_INTEGRITY_CRC
+     */
+    void setIntegrityMode(int mode);
+
+
+    /** Get the integrity check of the measurement
+     *
+     *  @return         SI70_INTEGRITY_NONE or SI70_INTEGRITY_CRC
+     */
+    int getIntegrityMode() const;
+
+
+    /** Select how measureTemperature() waits for the end of the conversion
+     *
+     *  SI70_COMPLETION_SLEEP (default) waits the maximum conversion time of
+     *  the resolution. SI70_COMPLETION_POLL tries to read every
+     *  pollIntervalUs, the sensor does not acknowledge the address until
+     *  the conversion is done, so a read ends after the address byte and
+     *  the result is collected as soon as it is ready.
+     *  SI70_COMPLETION_HOLD uses the hold master mode, the sensor stretches
+     *  the clock and the bus is blocked during the conversion.
+     *
+     *  @param  mode            SI70_COMPLETION_xxx
+     *  @param  pollIntervalUs  interval of SI70_COMPLETION_POLL in us
+     *  @return                 (0) if no error, (-1) if the mode is not supported
+     */
+    int setCompletionMode(int mode, uint32_t pollIntervalUs = SI70_POLL_INTERVAL_US);
+
+
+    /** Get the completion strategy of measureTemperature()
+     *
+     *  @return         SI70_COMPLETION_xxx
+     */
+    int getCompletionMode() const;
+
+
+    /** Check if a split-phase measurement is in progress
+     *
+     *  @return         true if a measurement was started and not yet collected
+     */
+    bool isMeasuring() const;
+
+
     /** Get the Firmware version of the Sensor
      *
+     *  served from the descriptor, if the sensor is initialized
      *
      *  @return         Firmware version:   0xFF = version 1.0
      *                                      0x20 = version 2.0
@@ -187,6 +429,7 @@ public:
      *  plus CRC Bytes in between. 
      *  Inside the ID, the code for different sensor devices is included
      *  which can be used to determine the sensor type.
+     *  Served from the descriptor, if the sensor is initialized.
      *
      *  @return         Sensor type:    50 = 0x32 = Si7050
      *                                  51 = 0x33 = Si7051
@@ -200,13 +443,92 @@ public:
 
     /**
      * Get the serial number of the sensor. The serial is stored in the
-     * argument.
+     * argument. Served from the descriptor, if the sensor is initialized.
      *
      * @param serial an 8 byte array for storing the serial number in
-     * @return 0 if successful
+     * @return 0 if successful, -1 if error or the CRC check failed
      */
     int getSerial(unsigned char serial[8]);
 
+    /** Read the descriptor of the sensor again
+     *
+     *  read the serial, ID, firmware version and user register from the
+     *  sensor and store them in the descriptor
+     *
+     *  @return         (0) if no error, (-1) if error, the descriptor is
+     *                  invalid in this case
+     */
+    int refreshDescriptor();
+
+    /** Get the descriptor of the sensor
+     *
+     *  @return         descriptor, check the valid flag before use
+     */
+    const SI7050Descriptor &getDescriptor() const;
+
+    /** Get the bus of the sensor
+     *
+     *  @return         bus object, which is also the time base of the driver
+     */
+    SI7050Bus &getBus();
+
+    /** Lock the instance for a sequence of calls, e.g. with a mux channel selection
+     *
+     *  The driver takes the instance mutex before the bus lock, a caller,
+     *  which also locks the bus, has to lock the instance first.
+     */
+    void lock();
+
+    /** Unlock the instance, see lock() */
+    void unlock();
+
+    /** Set the retry and recovery policy
+     *
+     *  applies to initialize(), setResolution(), refreshDescriptor() and
+     *  the measurements (measureTemperature(), getTemperature(),
+     *  measureSample()). CRC errors are not retried, see setIntegrityMode().
+     *
+     *  @param  policy  retry policy, all zero to fail at once (default)
+     */
+    void setRetryPolicy(const SI7050RetryPolicy &policy);
+
+    /** Get the retry and recovery policy */
+    const SI7050RetryPolicy &getRetryPolicy() const;
+
+    /** Get the counters of the retry policy
+     *
+     *  @return         how often each recovery step was needed
+     */
+    const SI7050RecoveryStats &getRecoveryStats() const;
+
+    /** Mark the shadow copy of the user register as stale
+     *
+     *  the next configuration reads the register from the sensor again,
+     *  use this if the sensor was powered off
+     */
+    void invalidateShadow();
+
+    /** Get the number of bus transfers saved by the shadow user register
+     *
+     *  @return         number of skipped bus transfers
+     */
+    uint32_t getSkippedTransactions() const;
+
+#ifdef SI70_STATS
+    /** Get the statistics of the instance
+     *
+     *  call counts, bytes on the wire and latency histogram per operation,
+     *  error counts per ERROR_xxx category and retries
+     *  (only with SI70_STATS defined)
+     *
+     *  @return         statistics
+     */
+    const SI7050Stats &getStats() const;
+
+    /** Reset the statistics of the instance */
+    void clearStats();
+#endif
+
 protected:
     /*!
      * Check the serial number with CRC.
@@ -218,33 +540,238 @@ protected:
 
 private:
 
-    I2C         *i2c_p;
-    I2C         &i2c;
-    char        address;
-    int         ret;
+    /*!
+     * Write the resolution bits into the user register.
+     *
+     * @param resBits   resolution bits (SI70_RES_xxBIT)
+     * @return          (0) if no error, none (0) if error
+     */
+    int writeResolution(char resBits);
 
+    /*!
+     * Convert the resolution between user register bits and number of bits.
+     */
+    static int resolutionFromBits(char resBits);
+    static int resolutionToBits(int bits);
 
     /*!
-     * Calculate the CRC8.
-     *
-     * @brief       the polynomial = x^8+x^5+x^4+1
-     *
-     * @param data  pointer to the data
-     * @param len   length of data
-     * @param init  CRC initilizer
-     * @return      calculated CRC
+     * Read the identity and the user register from the sensor.
      */
-    unsigned char crc8(unsigned char *data, uint8_t len, unsigned char init);
+    int readSerial(unsigned char serial[8]);
+    int readFirmwareVersion();
+    int readUserRegister(char *value);
 
     /*!
-     * Swap the bit order in single byte.
+     * Send the measure command and start the timeout.
+     */
+    int sendMeasure();
+
+    /*!
+     * End the split-phase measurement and call the callback.
      *
-     * @param input Byte to swap
-     * @return      swapped Byte
+     * @return          the status
+     */
+    int finishMeasurement(int status, const char *data);
+
+    /*!
+     * Single attempt of the operations with retry policy.
      */
-    unsigned char bitswap(unsigned char input);
+    int measureOnce(char *data);
+    int readDescriptor();
 
+    /*!
+     * Run an operation with the retry policy.
+     */
+    template<typename F>
+    int withRetries(F operation);
 
+    /*!
+     * Reset the sensor, wait until it answers and write the configuration.
+     */
+    int softReset();
+
+    /*!
+     * Measure in hold master mode, including the CRC retries.
+     */
+    int measureHold(char *data);
+
+    /*!
+     * Get the raw value of the latest sample, if it is not older than maxAgeUs.
+     */
+    bool readLatest(uint32_t maxAgeUs, uint16_t *raw) const;
+
+    /*!
+     * Record the statistics of an operation, empty without SI70_STATS.
+     */
+    void statsBegin(int op);
+    void statsEnd(int op, int status);
+    void statsError(int error);
+    void statsRetry(bool crc);
+
+#ifdef SI70_STATS
+    typedef SI7050StatsBus CoreBus;
+#else
+    typedef SI7050Bus CoreBus;
+#endif
+
+    SI7050Bus   &bus;
+#ifdef SI70_STATS
+    SI7050StatsBus statsBus;
+#endif
+    Si705x<CoreBus> core;
+    int         resolution;
+
+    mutable SI7050Mutex mutex;
+    SI7050LatestSample  latest;
+
+    bool            measuring;
+    uint32_t        measStart;
+    SI7050Callback  measCallback;
+    void            *measContext;
+    int             measRetries;
+    int             integrityMode;
+    int             completionMode;
+    uint32_t        pollInterval;
+
+    SI7050RetryPolicy   retryPolicy;
+    SI7050RecoveryStats recoveryStats;
+
+    SI7050Descriptor descriptor;
+    bool            shadowValid;
+    uint32_t        skippedTransactions;
+
+#ifdef SI70_STATS
+    SI7050Stats     stats;
+    uint32_t        statsStart[SI70_OPS];
+    uint32_t        statsBytes[SI70_OPS];
+#endif
 };
 
+#ifdef SI70_STATS
+inline void SI7050Device::statsBegin(int op) {
+    statsStart[op] = bus.readUs();
+    statsBytes[op] = statsBus.getBytes();
+}
+
+inline void SI7050Device::statsEnd(int op, int status) {
+    SI7050OpStats &opStats = stats.op[op];
+    uint32_t us = bus.readUs() - statsStart[op];
+
+    opStats.calls++;
+    opStats.failures += (status != 0);
+    opStats.bytes += statsBus.getBytes() - statsBytes[op];
+    opStats.histogram[SI7050Stats::bucket(us)]++;
+    if (us > opStats.maxUs) {
+        opStats.maxUs = us;
+    }
+}
+
+inline void SI7050Device::statsError(int error) {
+    stats.addError(error);
+}
+
+inline void SI7050Device::statsRetry(bool crc) {
+    if (crc) {
+        stats.crcRetries++;
+    } else {
+        stats.pollRetries++;
+    }
+}
+#else
+inline void SI7050Device::statsBegin(int) {}
+inline void SI7050Device::statsEnd(int, int) {}
+inline void SI7050Device::statsError(int) {}
+inline void SI7050Device::statsRetry(bool) {}
+#endif
+
+#ifdef __MBED__
+/** SI7050BusStorage class
+ *
+ *  In-object storage of the I2C master and the bus adapter, which the pin
+ *  and I2C constructors of SI7050 create in place, so the sensor does not
+ *  use the heap. It is a base class, so the bus exists before the device.
+ */
+class SI7050BusStorage
+{
+protected:
+    SI7050BusStorage() : i2c_p(NULL), bus_p(NULL) {}
+
+    SI7050BusStorage(PinName sda, PinName scl)
+            :
+            i2c_p(new(i2cStorage) SI7050I2C(sda, scl)),
+            bus_p(new(busStorage) SI7050I2CBus(*i2c_p)) {}
+
+    explicit SI7050BusStorage(I2C &i2c_obj)
+            :
+            i2c_p(NULL),
+            bus_p(new(busStorage) SI7050I2CBus(i2c_obj)) {}
+
+    ~SI7050BusStorage() {
+        if (bus_p) {
+            bus_p->~SI7050Bus();
+        }
+        if (i2c_p) {
+            i2c_p->~SI7050I2C();
+        }
+    }
+
+    alignas(SI7050I2C) unsigned char i2cStorage[sizeof(SI7050I2C)];
+    alignas(SI7050I2CBus) unsigned char busStorage[sizeof(SI7050I2CBus)];
+    SI7050I2C   *i2c_p;
+    SI7050Bus   *bus_p;
+
+private:
+    SI7050BusStorage(const SI7050BusStorage &);
+    SI7050BusStorage &operator=(const SI7050BusStorage &);
+};
+#endif
+
+/** SI7050 class
+ *
+ *  SI7050Device with the construction on pins or an I2C object. On mbed,
+ *  the I2C master and the bus adapter of these constructors are kept in
+ *  the object itself, see SI7050BusStorage. Sensors, which share a bus,
+ *  can be SI7050Device to save this storage.
+ */
+class SI7050
+#ifdef __MBED__
+        : private SI7050BusStorage, public SI7050Device
+#else
+        : public SI7050Device
+#endif
+{
+public:
+
+#ifdef __MBED__
+    /** Create a SI7050 instance
+     *  which is connected to specified I2C pins with specified address
+     *
+     * @param sda I2C-bus SDA pin
+     * @param scl I2C-bus SCL pin
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    SI7050(PinName sda, PinName sck, char slave_adr = (char) SI70_ADDRESS)
+            : SI7050BusStorage(sda, sck), SI7050Device(*bus_p, slave_adr) {}
+
+
+    /** Create a SI7050 instance
+     *  which is connected to specified I2C pins with specified address
+     *
+     * @param i2c_obj I2C object (instance)
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    explicit SI7050(I2C &i2c_obj, char slave_adr = (char) SI70_ADDRESS)
+            : SI7050BusStorage(i2c_obj), SI7050Device(*bus_p, slave_adr) {}
+#endif
+
+
+    /** Create a SI7050 instance
+     *  which is connected to the specified bus with specified address
+     *
+     * @param bus_obj bus object (instance), e.g. a simulated bus
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    explicit SI7050(SI7050Bus &bus_obj, char slave_adr = (char) SI70_ADDRESS)
+            : SI7050Device(bus_obj, slave_adr) {}
+};
 #endif // MBED_SI7050_H
@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Alarm.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Threshold alarms on raw SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Alarm.h"
+
+SI7050Alarm::SI7050Alarm(SI7050AlarmCallback callback_, void *context_)
+        :
+        count(0),
+        below(0),
+        active(0),
+        callback(callback_),
+        context(context_) {
+    /* nothing to do */
+}
+
+uint32_t SI7050Alarm::rawAtLeast(int centiCelsius) {
+    // T(raw) = ((17572 * raw) >> 16) - 4685 >= t  <=>  17572 * raw >= (t + 4685) << 16
+    int64_t scaled = ((int64_t) centiCelsius + 4685) * 65536;
+
+    if (scaled <= 0) {
+        return 0;
+    }
+    int64_t raw = (scaled + 17572 - 1) / 17572;
+    return raw > 0xFFFF ? 0x10000 : (uint32_t) raw;
+}
+
+uint32_t SI7050Alarm::rawAtLeast(int centiCelsius, uint16_t mask) {
+    // round up to the next code of the resolution, the conversion is monotonic
+    uint32_t unused = (uint16_t) ~mask;
+
+    return (rawAtLeast(centiCelsius) + unused) & ~unused;
+}
+
+int SI7050Alarm::add(int threshold, int hysteresis, int direction) {
+    if (count >= SI70_ALARM_MAX || (direction != SI70_ALARM_ABOVE && direction != SI70_ALARM_BELOW)) {
+        return -1;
+    }
+
+    if (direction == SI70_ALARM_BELOW) {
+        below |= 1u << count;
+    } else {
+        below &= ~(1u << count);
+    }
+    count++;
+    if (setThreshold(count - 1, threshold, hysteresis)) {
+        count--;
+        return -1;
+    }
+    return count - 1;
+}
+
+int SI7050Alarm::setThreshold(int alarm, int threshold, int hysteresis) {
+    if (alarm < 0 || alarm >= count || hysteresis < 0) {
+        return -1;
+    }
+
+    if (!((below >> alarm) & 1)) {
+        // T >= threshold activates, T < threshold - hysteresis clears
+        limits[alarm][0] = rawAtLeast(threshold);
+        limits[alarm][1] = rawAtLeast(threshold - hysteresis);
+    } else {
+        // T <= threshold activates, T > threshold + hysteresis clears
+        limits[alarm][0] = rawAtLeast(threshold + 1);
+        limits[alarm][1] = rawAtLeast(threshold + hysteresis + 1);
+    }
+    return 0;
+}
+
+uint32_t SI7050Alarm::update(uint16_t raw) {
+    uint32_t previous = active;
+
+    // an active alarm compares against its clear code, an inactive one
+    // against its set code, without branches
+    uint32_t next = 0;
+    for (int i = 0; i < count; i++) {
+        next |= (uint32_t) (raw >= limits[i][(active >> i) & 1]) << i;
+    }
+    active = next ^ below;
+
+    uint32_t changed = active ^ previous;
+    if (callback) {
+        for (int i = 0; changed; i++, changed >>= 1) {
+            if (changed & 1) {
+                callback(context, i, (active >> i) & 1, raw);
+            }
+        }
+    }
+    return active;
+}
+
+bool SI7050Alarm::isActive(int alarm) const {
+    return alarm >= 0 && alarm < count && (active >> alarm) & 1;
+}
+
+uint32_t SI7050Alarm::getActive() const {
+    return active;
+}
+
+int SI7050Alarm::getCount() const {
+    return count;
+}
+
+void SI7050Alarm::reset() {
+    active = 0;
+}
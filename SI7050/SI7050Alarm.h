@@ -0,0 +1,144 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Alarm.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Threshold alarms on raw SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_ALARM_H
+#define MBED_SI7050_ALARM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SI70_ALARM_MAX          8
+
+// direction of an alarm
+#define SI70_ALARM_ABOVE        0       // active at or above the threshold
+#define SI70_ALARM_BELOW        1       // active at or below the threshold
+
+/** Alarm callback, called on every change of the state of an alarm
+ *
+ * @param context   user context, which was given to the alarm engine
+ * @param alarm     index of the alarm, as returned by add()
+ * @param active    new state of the alarm
+ * @param raw       the raw sample, which changed the state
+ */
+typedef void (*SI7050AlarmCallback)(void *context, int alarm, bool active, uint16_t raw);
+
+/** SI7050Alarm class
+ *
+ *  Compare raw samples against temperature thresholds without converting
+ *  them. The thresholds and hysteresis bands are converted to raw codes
+ *  once, by the inverse of SI7050::calcTemperature(), so the result is the
+ *  same as comparing the converted temperature.
+ *  An alarm, which is active above its threshold, is cleared below the
+ *  threshold minus the hysteresis (and the other way round for below).
+ *
+ * @code
+ * SI7050Alarm alarms(changed, &context);
+ * alarms.add(8000, 200, SI70_ALARM_ABOVE);     // over 80°C, clear under 78°C
+ * alarms.add(-1000, 50, SI70_ALARM_BELOW);     // frost
+ *
+ * alarms.update(sample.raw & sensor.getRawMask());
+ * @endcode
+ */
+class SI7050Alarm
+{
+public:
+
+    /** Create an alarm engine without alarms
+     *
+     * @param callback_     (option) called on each change of an alarm
+     * @param context_      (option) user context for the callback
+     */
+    SI7050Alarm(SI7050AlarmCallback callback_ = NULL, void *context_ = NULL);
+
+    /** Add an alarm
+     *
+     * @param threshold     threshold in 0.01°C
+     * @param hysteresis    hysteresis in 0.01°C (>= 0)
+     * @param direction     SI70_ALARM_ABOVE or SI70_ALARM_BELOW
+     * @return              index of the alarm, (-1) if the engine is full
+     *                      or a parameter is invalid
+     */
+    int add(int threshold, int hysteresis, int direction);
+
+    /** Change the threshold and hysteresis of an alarm, the state is kept
+     *
+     * @param alarm         index of the alarm
+     * @param threshold     threshold in 0.01°C
+     * @param hysteresis    hysteresis in 0.01°C (>= 0)
+     * @return              (0) if changed, (-1) if a parameter is invalid
+     */
+    int setThreshold(int alarm, int threshold, int hysteresis);
+
+    /** Evaluate all alarms for a sample and call the callback for each
+     *  alarm, which changed its state
+     *
+     * @param raw           raw 16 bit temperature code, masked with
+     *                      SI7050::getRawMask()
+     * @return              bit mask of the active alarms
+     */
+    uint32_t update(uint16_t raw);
+
+    /** Get the state of an alarm */
+    bool isActive(int alarm) const;
+
+    /** Get the bit mask of the active alarms */
+    uint32_t getActive() const;
+
+    /** Get the number of alarms */
+    int getCount() const;
+
+    /** Clear the state of all alarms, e.g. after a restart of the sensor */
+    void reset();
+
+    /** Get the smallest raw code, which converts to at least a temperature
+     *
+     * @param centiCelsius  temperature in 0.01°C
+     * @return              raw code, 0x10000 if no code reaches it
+     */
+    static uint32_t rawAtLeast(int centiCelsius);
+
+    /** Get the smallest raw code of a resolution, which converts to at least
+     *  a temperature
+     *
+     * @param centiCelsius  temperature in 0.01°C
+     * @param mask          raw data mask of the resolution, e.g.
+     *                      SI7050::getRawMask()
+     * @return              raw code, 0x10000 if no code reaches it
+     */
+    static uint32_t rawAtLeast(int centiCelsius, uint16_t mask);
+
+private:
+    // limits[i][state]: the raw code, at and above which the next state of an
+    // above alarm is active, or of a below alarm is inactive
+    uint32_t            limits[SI70_ALARM_MAX][2];
+    int                 count;
+    uint32_t            below;      // bit mask of the below alarms
+    uint32_t            active;
+    SI7050AlarmCallback callback;
+    void                *context;
+};
+
+#endif // MBED_SI7050_ALARM_H
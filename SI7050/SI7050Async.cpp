@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Async.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Asynchronous driver of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Async.h"
+
+SI7050Async::SI7050Async(SI7050AsyncBus &bus_obj, char slave_adr)
+        :
+        bus(bus_obj),
+        address(slave_adr),
+        resolution(14),
+        integrityMode(SI70_INTEGRITY_NONE),
+        state(IDLE),
+        callback(NULL),
+        context(NULL),
+        measStart(0),
+        measRetries(0),
+        cmd(),
+        buffer(),
+        serial() {
+    /* nothing to do */
+}
+
+int SI7050Async::initialize(SI7050Callback callback_, void *context_) {
+    if (begin(INIT_READ, callback_, context_)) {
+        return -1;
+    }
+
+    cmd[0] = (char) SI70_READ_UR;
+    return transfer(INIT_READ, cmd, 1, buffer, 1);
+}
+
+int SI7050Async::measureTemperature(SI7050Callback callback_, void *context_) {
+    if (begin(MEAS_START, callback_, context_)) {
+        return -1;
+    }
+
+    measRetries = 0;
+    return sendMeasure();
+}
+
+int SI7050Async::getSerial(SI7050Callback callback_, void *context_) {
+    if (begin(SERIAL_1, callback_, context_)) {
+        return -1;
+    }
+
+    cmd[0] = (char) SI70_READ_ID_11;
+    cmd[1] = (char) SI70_READ_ID_12;
+    return transfer(SERIAL_1, cmd, 2, buffer, 8);
+}
+
+int SI7050Async::setResolution(int bits) {
+    if (!Si705xResolutions::supported(bits) || state != IDLE) {
+        return -1;
+    }
+    resolution = bits;
+    return 0;
+}
+
+int SI7050Async::getResolution() const {
+    return resolution;
+}
+
+void SI7050Async::setIntegrityMode(int mode) {
+    integrityMode = mode;
+}
+
+bool SI7050Async::isBusy() const {
+    return state != IDLE;
+}
+
+int SI7050Async::begin(State first, SI7050Callback callback_, void *context_) {
+    if (state != IDLE) {
+        return -1;
+    }
+
+    state = first;
+    callback = callback_;
+    context = context_;
+    return 0;
+}
+
+int SI7050Async::transfer(State next, const char *tx, int txLength, char *rx, int rxLength) {
+    state = next;
+    if (bus.transfer(address, tx, txLength, rx, rxLength, &SI7050Async::onEvent, this)) {
+        state = IDLE;
+        return -1;
+    }
+    return 0;
+}
+
+int SI7050Async::sendMeasure() {
+    measStart = bus.readUs();
+    cmd[0] = (char) SI70_MEASURE;
+    return transfer(MEAS_START, cmd, 1, NULL, 0);
+}
+
+uint32_t SI7050Async::getConversionTime() const {
+    return Si705xResolutions::fromBits(resolution).conversionUs;
+}
+
+void SI7050Async::finish(int status, const char *data) {
+    state = IDLE;
+    if (callback != NULL) {
+        callback(context, status, data);
+    }
+}
+
+void SI7050Async::onEvent(void *self, int event) {
+    static_cast<SI7050Async *>(self)->onEvent(event);
+}
+
+void SI7050Async::onEvent(int event) {
+    int length = (integrityMode == SI70_INTEGRITY_CRC) ? 3 : 2;
+
+    switch (state) {
+        case INIT_READ:
+            if (event != SI70_BUS_DONE) {
+                break;
+            }
+            cmd[0] = (char) SI70_WRITE_UR;
+            cmd[1] = (char) ((buffer[0] & ~SI70_RES_MASK) | Si705xResolutions::fromBits(resolution).userRegister);
+            if (transfer(INIT_WRITE, cmd, 2, NULL, 0)) {
+                break;
+            }
+            return;
+
+        case INIT_WRITE:
+            finish(event == SI70_BUS_DONE ? 0 : -1, NULL);
+            return;
+
+        case MEAS_START:
+            if (event != SI70_BUS_DONE) {
+                break;
+            }
+            state = MEAS_WAIT;
+            if (bus.schedule(getConversionTime(), &SI7050Async::onEvent, this)) {
+                break;
+            }
+            return;
+
+        case MEAS_WAIT:
+            if (transfer(MEAS_READ, NULL, 0, buffer, length)) {
+                break;
+            }
+            return;
+
+        case MEAS_READ:
+            // the sensor does not acknowledge the read, until the conversion is done
+            if (event == SI70_BUS_NACK && (uint32_t) (bus.readUs() - measStart) < 2 * getConversionTime()) {
+                state = MEAS_WAIT;
+                if (bus.schedule(SI70_POLL_INTERVAL_US, &SI7050Async::onEvent, this)) {
+                    break;
+                }
+                return;
+            }
+            if (event != SI70_BUS_DONE) {
+                break;
+            }
+            if (integrityMode == SI70_INTEGRITY_CRC && !SI7050Crc::check((const unsigned char *) buffer)) {
+                // measure again, as the sensor does not repeat the result
+                if (measRetries >= SI70_CRC_RETRIES) {
+                    finish(SI70_ERROR_CRC, NULL);
+                    return;
+                }
+                measRetries++;
+                if (sendMeasure()) {
+                    break;
+                }
+                return;
+            }
+            finish(0, buffer);
+            return;
+
+        case SERIAL_1:
+            if (event != SI70_BUS_DONE) {
+                break;
+            }
+            cmd[0] = (char) SI70_READ_ID_21;
+            cmd[1] = (char) SI70_READ_ID_22;
+            if (transfer(SERIAL_2, cmd, 2, &buffer[8], 8)) {
+                break;
+            }
+            return;
+
+        case SERIAL_2:
+            if (event != SI70_BUS_DONE || !Si705xSerial::check((const unsigned char *) buffer)) {
+                break;
+            }
+            Si705xSerial::decode(buffer, serial);
+            finish(0, (const char *) serial);
+            return;
+
+        default:
+            return;
+    }
+
+    finish(-1, NULL);
+}
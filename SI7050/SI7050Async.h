@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Async.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Asynchronous driver of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_ASYNC_H
+#define MBED_SI7050_ASYNC_H
+
+#include "SI7050.h"
+#include "SI7050AsyncBus.h"
+
+/** SI7050Async class
+ *
+ *  Event driven variant of the SI7050 driver. The command sequences of
+ *  initialize(), measureTemperature() and getSerial() run as a chain of
+ *  asynchronous transfers and timers, the calls return immediately and
+ *  the result is delivered to a callback. One operation runs at a time.
+ *  The steps of the chain and the callback run in the thread context of
+ *  the bus (SI7050I2CAsyncBus: the thread, which dispatches the queue).
+ *
+ * @code
+ * I2C i2c(I2C_SDA, I2C_SCL);
+ * EventQueue queue;
+ * SI7050I2CAsyncBus bus(i2c, queue);
+ * SI7050Async sensor(bus);
+ *
+ * void measured(void *context, int status, const char *data) {
+ *     if (!status) printf("raw = %02x%02x\r\n", data[0], data[1]);
+ * }
+ *
+ * sensor.measureTemperature(measured);
+ * queue.dispatch_forever();
+ * @endcode
+ */
+class SI7050Async
+{
+public:
+
+    /** Create a SI7050Async instance
+     *  which is connected to the specified bus with specified address
+     *
+     * @param bus_obj bus object (instance)
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    explicit SI7050Async(SI7050AsyncBus &bus_obj, char slave_adr = (char) SI70_ADDRESS);
+
+    /** Write the selected resolution into the user register
+     *
+     *  @param  callback    completion callback, data is NULL
+     *  @param  context     user context, which is handed to the callback
+     *  @return             (0) if started, (-1) if busy or error
+     */
+    int initialize(SI7050Callback callback, void *context = NULL);
+
+    /** Measure the temperature
+     *
+     *  wait the conversion time, then poll the sensor until it acknowledges
+     *
+     *  @param  callback    completion callback, data is the raw
+     *                      temperature (2 Bytes), status see
+     *                      SI7050::measureTemperature()
+     *  @param  context     user context, which is handed to the callback
+     *  @return             (0) if started, (-1) if busy or error
+     */
+    int measureTemperature(SI7050Callback callback, void *context = NULL);
+
+    /** Read the electronic ID of the sensor
+     *
+     *  @param  callback    completion callback, data is the serial
+     *                      number (8 Bytes), status is (-1) if the
+     *                      CRC check failed
+     *  @param  context     user context, which is handed to the callback
+     *  @return             (0) if started, (-1) if busy or error
+     */
+    int getSerial(SI7050Callback callback, void *context = NULL);
+
+    /** Select the resolution, written by the next initialize()
+     *
+     *  @param  bits        resolution in bits (11, 12, 13 or 14)
+     *  @return             (0) if no error, (-1) if not supported or busy
+     */
+    int setResolution(int bits);
+
+    /** Get the selected resolution */
+    int getResolution() const;
+
+    /** Select the integrity check of the measurement, see SI7050::setIntegrityMode() */
+    void setIntegrityMode(int mode);
+
+    /** Check if an operation is in progress */
+    bool isBusy() const;
+
+private:
+    enum State {
+        IDLE,
+        INIT_READ,
+        INIT_WRITE,
+        MEAS_START,
+        MEAS_WAIT,
+        MEAS_READ,
+        SERIAL_1,
+        SERIAL_2
+    };
+
+    SI7050AsyncBus  &bus;
+    char            address;
+    int             resolution;
+    int             integrityMode;
+
+    volatile State  state;
+    SI7050Callback  callback;
+    void            *context;
+    uint32_t        measStart;
+    int             measRetries;
+    char            cmd[2];
+    char            buffer[16];
+    unsigned char   serial[8];
+
+    int begin(State first, SI7050Callback callback_, void *context_);
+    int transfer(State next, const char *tx, int txLength, char *rx, int rxLength);
+    int sendMeasure();
+    uint32_t getConversionTime() const;
+    void finish(int status, const char *data);
+    void onEvent(int event);
+    static void onEvent(void *self, int event);
+};
+
+#endif // MBED_SI7050_ASYNC_H
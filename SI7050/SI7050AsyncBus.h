@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file    SI7050AsyncBus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Asynchronous bus interface of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_ASYNC_BUS_H
+#define MBED_SI7050_ASYNC_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __MBED__
+#include "mbed.h"
+#endif
+
+// events of an asynchronous transfer
+#define SI70_BUS_DONE   0       // transfer complete
+#define SI70_BUS_NACK   1       // the slave did not acknowledge
+#define SI70_BUS_ERROR  2       // other bus error
+
+/** Completion callback of an asynchronous transfer or timer
+ *
+ * @param context   user context, which was given with the transfer
+ * @param event     SI70_BUS_xxx, always SI70_BUS_DONE for a timer
+ */
+typedef void (*SI7050BusCallback)(void *context, int event);
+
+/** SI7050AsyncBus class
+ *
+ *  Interface between the asynchronous SI7050 driver and an interrupt or
+ *  DMA driven I2C bus, including a one-shot timer for the conversion time.
+ *  The callbacks are called from thread context, as they start the next
+ *  transfer. Only one transfer and one timer are pending at a time.
+ */
+class SI7050AsyncBus
+{
+public:
+
+    virtual ~SI7050AsyncBus() {}
+
+    /** Start a transfer, which writes and then reads with a repeated start
+     *
+     * @param address   8 bit I2C address
+     * @param tx        data to write, valid until the callback (may be NULL)
+     * @param txLength  number of bytes to write (0 for a read only)
+     * @param rx        storage for the read data (may be NULL)
+     * @param rxLength  number of bytes to read (0 for a write only)
+     * @param callback  function to call on completion
+     * @param context   user context, which is handed to the callback
+     * @return          (0) if the transfer was started, none (0) if busy
+     */
+    virtual int transfer(int address, const char *tx, int txLength, char *rx, int rxLength,
+                         SI7050BusCallback callback, void *context) = 0;
+
+    /** Call a function after a delay
+     *
+     * @param us        delay in us
+     * @param callback  function to call
+     * @param context   user context, which is handed to the callback
+     * @return          (0) if the timer was started, none (0) if error
+     */
+    virtual int schedule(uint32_t us, SI7050BusCallback callback, void *context) = 0;
+
+    /** Read the time base of the bus
+     *
+     * @return          free running time in us
+     */
+    virtual uint32_t readUs() = 0;
+};
+
+#if defined(__MBED__) && DEVICE_I2C_ASYNCH
+
+/** SI7050I2CAsyncBus class
+ *
+ *  SI7050AsyncBus implementation on top of the event API of the mbed I2C
+ *  driver (I2C::transfer()), the CPU can sleep during the transfers.
+ *
+ *  The I2C and timer events arrive in interrupt context, where the I2C
+ *  mutex must not be taken. They are deferred to the event queue, the
+ *  callbacks run in the thread, which dispatches it.
+ */
+class SI7050I2CAsyncBus final : public SI7050AsyncBus
+{
+public:
+
+    /** Create a bus for the given I2C object
+     *
+     * @param i2c_obj   I2C object (instance)
+     * @param queue_obj event queue, which calls the callbacks
+     */
+    SI7050I2CAsyncBus(I2C &i2c_obj, EventQueue &queue_obj)
+            : i2c(i2c_obj), queue(queue_obj), transferCallback(NULL), transferContext(NULL),
+              timerCallback(NULL), timerContext(NULL) {}
+
+    virtual int transfer(int address, const char *tx, int txLength, char *rx, int rxLength,
+                         SI7050BusCallback callback, void *context) {
+        transferCallback = callback;
+        transferContext = context;
+        return i2c.transfer(address, tx, txLength, rx, rxLength,
+                            event_callback_t(this, &SI7050I2CAsyncBus::onTransfer), I2C_EVENT_ALL, false);
+    }
+
+    virtual int schedule(uint32_t us, SI7050BusCallback callback, void *context) {
+        timerCallback = callback;
+        timerContext = context;
+        timeout.attach_us(mbed::callback(this, &SI7050I2CAsyncBus::onTimeout), us);
+        return 0;
+    }
+
+    virtual uint32_t readUs() {
+        return us_ticker_read();
+    }
+
+private:
+    I2C                 &i2c;
+    EventQueue          &queue;
+    Timeout             timeout;
+    SI7050BusCallback   transferCallback;
+    void                *transferContext;
+    SI7050BusCallback   timerCallback;
+    void                *timerContext;
+
+    // interrupt context: the next step of the driver runs in the thread of the queue
+    void onTransfer(int event) {
+        int status = SI70_BUS_ERROR;
+
+        if (event & I2C_EVENT_TRANSFER_COMPLETE) {
+            status = SI70_BUS_DONE;
+        } else if (event & (I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)) {
+            status = SI70_BUS_NACK;
+        }
+        queue.call(transferCallback, transferContext, status);
+    }
+
+    void onTimeout() {
+        queue.call(timerCallback, timerContext, (int) SI70_BUS_DONE);
+    }
+};
+
+#endif // __MBED__ && DEVICE_I2C_ASYNCH
+
+#endif // MBED_SI7050_ASYNC_BUS_H
@@ -0,0 +1,216 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Bus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Bus interface of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_BUS_H
+#define MBED_SI7050_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __MBED__
+#include "mbed.h"
+#endif
+
+#define SI70_RECOVER_CLOCKS     9   // SCL pulses to clock out a stuck slave
+#define SI70_RECOVER_HALF_US    5   // half SCL period of the recovery (100 kHz)
+
+/** SI7050Bus class
+ *
+ *  Interface between the SI7050 driver and the I2C bus, including the
+ *  time base the driver uses for waiting on the sensor.
+ *  Transfers, which belong together, are enclosed in lock() and unlock(),
+ *  so other users of a shared bus can not interleave them.
+ *  The transfer functions follow the mbed I2C semantic: the address is the
+ *  8 bit address and the return value is (0) on ACK and none (0) on NACK.
+ */
+class SI7050Bus
+{
+public:
+
+    virtual ~SI7050Bus() {}
+
+    /** Write to an I2C slave
+     *
+     * @param address   8 bit I2C slave address
+     * @param data      data to write
+     * @param length    number of bytes to write
+     * @param repeated  repeated start, true - do not send stop at the end
+     * @return          (0) on success (ACK), none (0) on failure (NACK)
+     */
+    virtual int write(int address, const char *data, int length, bool repeated) = 0;
+
+    /** Read from an I2C slave
+     *
+     * @param address   8 bit I2C slave address
+     * @param data      storage for the read data
+     * @param length    number of bytes to read
+     * @param repeated  repeated start, true - do not send stop at the end
+     * @return          (0) on success (ACK), none (0) on failure (NACK)
+     */
+    virtual int read(int address, char *data, int length, bool repeated) = 0;
+
+    /** Wait for the given time
+     *
+     * @param us        time to wait in us
+     */
+    virtual void waitUs(uint32_t us) = 0;
+
+    /** Read the time base of the bus
+     *
+     * @return          free running time in us
+     */
+    virtual uint32_t readUs() = 0;
+
+    /** Get exclusive access to the bus (recursive), default: no locking */
+    virtual void lock() {}
+
+    /** Release the exclusive access to the bus */
+    virtual void unlock() {}
+
+    /** Free the bus, if a slave holds SDA low (e.g. after a brown-out):
+     *  clock out the slave with up to 9 SCL pulses and send a STOP
+     *
+     * @return          (0) if SDA is released, none (0) if it is still
+     *                  held or the bus can not recover (default)
+     */
+    virtual int recover() { return -1; }
+};
+
+#ifdef __MBED__
+
+/** SI7050I2C class
+ *
+ *  I2C with bus recovery. The pins are switched to GPIO to clock out a
+ *  slave, which holds SDA low, and the I2C peripheral is initialized again.
+ */
+class SI7050I2C : public I2C
+{
+public:
+
+    /** Create an I2C master with bus recovery
+     *
+     * @param sda I2C-bus SDA pin
+     * @param scl I2C-bus SCL pin
+     */
+    SI7050I2C(PinName sda, PinName scl) : I2C(sda, scl), sdaPin(sda), sclPin(scl) {}
+
+    /** Clock out a stuck slave
+     *
+     * @return          (0) if SDA is released, none (0) if it is still held
+     */
+    int recover() {
+        int ret;
+
+        lock();
+        {
+            DigitalInOut sda(sdaPin, PIN_INPUT, PullUp, 1);
+            DigitalInOut scl(sclPin, PIN_OUTPUT, PullUp, 1);
+
+            for (int i = 0; i < SI70_RECOVER_CLOCKS && !sda.read(); i++) {
+                scl = 0;
+                wait_us(SI70_RECOVER_HALF_US);
+                scl = 1;
+                wait_us(SI70_RECOVER_HALF_US);
+            }
+
+            // STOP: SDA rises while SCL is high
+            sda.output();
+            sda = 0;
+            wait_us(SI70_RECOVER_HALF_US);
+            sda = 1;
+            wait_us(SI70_RECOVER_HALF_US);
+            sda.input();
+            ret = sda.read() ? 0 : -1;
+        }
+        i2c_init(&_i2c, sdaPin, sclPin);
+        i2c_frequency(&_i2c, _hz);
+        unlock();
+
+        return ret;
+    }
+
+private:
+    PinName sdaPin;
+    PinName sclPin;
+};
+
+/** SI7050I2CBus class
+ *
+ *  SI7050Bus implementation on top of the mbed I2C driver. The class is
+ *  final, so the calls of Si705x<SI7050I2CBus> are not virtual.
+ */
+class SI7050I2CBus final : public SI7050Bus
+{
+public:
+
+    /** Create a bus for the given I2C object
+     *
+     * @param i2c_obj I2C object (instance)
+     */
+    explicit SI7050I2CBus(I2C &i2c_obj) : i2c(i2c_obj), recoverable(NULL) {}
+
+    /** Create a bus with recovery for the given I2C object
+     *
+     * @param i2c_obj I2C object with bus recovery (instance)
+     */
+    explicit SI7050I2CBus(SI7050I2C &i2c_obj) : i2c(i2c_obj), recoverable(&i2c_obj) {}
+
+    virtual int write(int address, const char *data, int length, bool repeated) {
+        return i2c.write(address, data, length, repeated);
+    }
+
+    virtual int read(int address, char *data, int length, bool repeated) {
+        return i2c.read(address, data, length, repeated);
+    }
+
+    virtual void waitUs(uint32_t us) {
+        wait_us((int) us);
+    }
+
+    virtual uint32_t readUs() {
+        return us_ticker_read();
+    }
+
+    virtual void lock() {
+        i2c.lock();
+    }
+
+    virtual void unlock() {
+        i2c.unlock();
+    }
+
+    virtual int recover() {
+        return recoverable ? recoverable->recover() : -1;
+    }
+
+private:
+    I2C &i2c;
+    SI7050I2C *recoverable;
+};
+
+#endif // __MBED__
+
+#endif // MBED_SI7050_BUS_H
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Convert.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Batched conversion of raw SI7050 data into temperature values
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Convert.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * All paths use: T = ((17572 * raw) >> 16) - 4685
+ * The product of two 16 bit values shifted by 16 is the high half of an
+ * unsigned 16 x 16 bit multiplication, which all SIMD units provide.
+ * The result is in the range -4685 ... 12886 and fits into int16_t.
+ */
+
+void SI7050Convert::convertScalar(const uint8_t *raw, int16_t *out, size_t count, uint16_t mask) {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t value = (uint16_t) (((raw[2 * i] << 8) | raw[2 * i + 1]) & mask);
+        out[i] = toCentiCelsius(value);
+    }
+}
+
+void SI7050Convert::convert(const uint8_t *raw, int16_t *out, size_t count, uint16_t mask) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i factor = _mm256_set1_epi16((short) 17572);
+    const __m256i offset = _mm256_set1_epi16(4685);
+    const __m256i vmask = _mm256_set1_epi16((short) mask);
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (raw + 2 * i));
+        v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));    // MSB first to little endian
+        v = _mm256_and_si256(v, vmask);
+        v = _mm256_sub_epi16(_mm256_mulhi_epu16(v, factor), offset);
+        _mm256_storeu_si256((__m256i *) (out + i), v);
+    }
+#elif defined(__SSE2__)
+    const __m128i factor = _mm_set1_epi16((short) 17572);
+    const __m128i offset = _mm_set1_epi16(4685);
+    const __m128i vmask = _mm_set1_epi16((short) mask);
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (raw + 2 * i));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));    // MSB first to little endian
+        v = _mm_and_si128(v, vmask);
+        v = _mm_sub_epi16(_mm_mulhi_epu16(v, factor), offset);
+        _mm_storeu_si128((__m128i *) (out + i), v);
+    }
+#elif defined(__ARM_NEON)
+    const uint16x4_t factor = vdup_n_u16(17572);
+    const int16x8_t offset = vdupq_n_s16(4685);
+    const uint16x8_t vmask = vdupq_n_u16(mask);
+
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t v = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(raw + 2 * i)));  // MSB first to little endian
+        v = vandq_u16(v, vmask);
+        uint16x4_t low = vshrn_n_u32(vmull_u16(vget_low_u16(v), factor), 16);
+        uint16x4_t high = vshrn_n_u32(vmull_u16(vget_high_u16(v), factor), 16);
+        int16x8_t t = vsubq_s16(vreinterpretq_s16_u16(vcombine_u16(low, high)), offset);
+        vst1q_s16(out + i, t);
+    }
+#endif
+
+    convertScalar(raw + 2 * i, out + i, count - i, mask);
+}
+
+const char *SI7050Convert::path() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#elif defined(__ARM_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
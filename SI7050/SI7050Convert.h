@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Convert.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Batched conversion of raw SI7050 data into temperature values
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_CONVERT_H
+#define MBED_SI7050_CONVERT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// raw data masks for the resolutions, the sensor does not use the lower bits
+#define SI70_MASK_14BIT     0xFFFC
+#define SI70_MASK_13BIT     0xFFF8
+#define SI70_MASK_12BIT     0xFFF0
+#define SI70_MASK_11BIT     0xFFE0
+
+/** SI7050Convert class
+ *
+ *  Convert buffers of raw sensor data (2 Bytes per sample, MSB first, as
+ *  read from the sensor) into temperature values in 0.01°C. The results
+ *  are equal to SI7050::calcTemperature() for every input.
+ *  The SIMD path is selected at compile time (AVX2, SSE2 or NEON) and
+ *  falls back to the portable scalar path.
+ *
+ * @code
+ * uint8_t raw[2 * 1000];    // logged raw data
+ * int16_t temperatures[1000];
+ * SI7050Convert::convert(raw, temperatures, 1000, SI70_MASK_14BIT);
+ * @endcode
+ */
+class SI7050Convert
+{
+public:
+
+    /** Convert raw data with the fastest available path
+     *
+     * @param raw       raw data, 2 Bytes per sample, MSB first
+     * @param out       storage for the temperatures in 0.01°C
+     * @param count     number of samples
+     * @param mask      raw data mask of the resolution (SI70_MASK_xxBIT)
+     */
+    static void convert(const uint8_t *raw, int16_t *out, size_t count, uint16_t mask = SI70_MASK_14BIT);
+
+    /** Convert raw data with the portable scalar path
+     *
+     * @param raw       raw data, 2 Bytes per sample, MSB first
+     * @param out       storage for the temperatures in 0.01°C
+     * @param count     number of samples
+     * @param mask      raw data mask of the resolution (SI70_MASK_xxBIT)
+     */
+    static void convertScalar(const uint8_t *raw, int16_t *out, size_t count, uint16_t mask = SI70_MASK_14BIT);
+
+    /** Convert a single raw value
+     *
+     * @param raw       raw 16 bit temperature code
+     * @return          temperature in 0.01°C
+     */
+    static inline int16_t toCentiCelsius(uint16_t raw) {
+        return (int16_t) (((17572u * raw) >> 16) - 4685);
+    }
+
+    /** Get the name of the path used by convert() */
+    static const char *path();
+};
+
+#endif // MBED_SI7050_CONVERT_H
@@ -0,0 +1,38 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Crc.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   CRC-8 engine of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Crc.h"
+
+// both tables are defined, so calcTable() and calcNibble() can always be
+// called; each table is in a section of its own, the linker drops the one,
+// which is not used (-fdata-sections -Wl,--gc-sections)
+constexpr SI7050CrcTable<8> SI7050Crc::table;
+constexpr SI7050CrcTable<4> SI7050Crc::nibbleTable;
+
+// check the tables at compile time with a part of the electronic ID of a real sensor
+static constexpr unsigned char crcExample[3] = {0x32, 0xff, 0xc7};
+static_assert(SI7050Crc::calcTable(crcExample, 2) == 0xc7, "wrong CRC table");
+static_assert(SI7050Crc::calcNibble(crcExample, 2) == 0xc7, "wrong CRC nibble table");
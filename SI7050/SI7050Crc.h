@@ -0,0 +1,130 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Crc.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   CRC-8 engine of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_CRC_H
+#define MBED_SI7050_CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SI70_CRC_POLYNOMIAL 0x31    // x^8+x^5+x^4+1
+
+// define SI70_CRC_NIBBLE_TABLE to use a 16 Byte table instead of 256 Byte
+// for small flash devices, which needs two lookups per Byte; the linker
+// drops the unused table with -fdata-sections -Wl,--gc-sections
+
+/** SI7050CrcTable struct
+ *
+ *  CRC lookup table, which is generated at compile time.
+ *
+ * @tparam  BITS    number of bits processed per lookup (4 or 8)
+ */
+template<int BITS>
+struct SI7050CrcTable
+{
+    unsigned char value[1 << BITS];
+
+    constexpr SI7050CrcTable() : value() {
+        for (int i = 0; i < (1 << BITS); i++) {
+            unsigned int crc = (unsigned int) i << (8 - BITS);
+            for (int j = 0; j < BITS; j++) {
+                crc = (crc & 0x80) ? (crc << 1) ^ SI70_CRC_POLYNOMIAL : (crc << 1);
+            }
+            value[i] = (unsigned char) crc;
+        }
+    }
+};
+
+/** SI7050Crc class
+ *
+ *  CRC-8 of the sensor (polynomial 0x31, MSB first, no reflection), as used
+ *  for the electronic ID and the measurement data.
+ */
+class SI7050Crc
+{
+public:
+
+    static constexpr SI7050CrcTable<8> table = SI7050CrcTable<8>();
+    static constexpr SI7050CrcTable<4> nibbleTable = SI7050CrcTable<4>();
+
+    /** Calculate the CRC with the 256 Byte table
+     *
+     * @param data  pointer to the data
+     * @param len   length of data
+     * @param init  CRC initializer, or the CRC of the preceding data
+     * @return      calculated CRC
+     */
+    static constexpr unsigned char calcTable(const unsigned char *data, size_t len, unsigned char init = 0) {
+        unsigned char crc = init;
+        for (size_t i = 0; i < len; i++) {
+            crc = table.value[crc ^ data[i]];
+        }
+        return crc;
+    }
+
+    /** Calculate the CRC with the 16 Byte table
+     *
+     * @param data  pointer to the data
+     * @param len   length of data
+     * @param init  CRC initializer, or the CRC of the preceding data
+     * @return      calculated CRC
+     */
+    static constexpr unsigned char calcNibble(const unsigned char *data, size_t len, unsigned char init = 0) {
+        unsigned char crc = init;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            crc = (unsigned char) ((crc << 4) ^ nibbleTable.value[crc >> 4]);
+            crc = (unsigned char) ((crc << 4) ^ nibbleTable.value[crc >> 4]);
+        }
+        return crc;
+    }
+
+    /** Calculate the CRC with the configured table
+     *
+     * @param data  pointer to the data
+     * @param len   length of data
+     * @param init  CRC initializer, or the CRC of the preceding data
+     * @return      calculated CRC
+     */
+    static constexpr unsigned char calc(const unsigned char *data, size_t len, unsigned char init = 0) {
+#ifdef SI70_CRC_NIBBLE_TABLE
+        return calcNibble(data, len, init);
+#else
+        return calcTable(data, len, init);
+#endif
+    }
+
+    /** Check two data Bytes followed by their CRC, as sent by the sensor
+     *
+     * @param data  pointer to MSB, LSB and CRC
+     * @return      true if the CRC matches
+     */
+    static constexpr bool check(const unsigned char *data) {
+        return calc(data, 2) == data[2];
+    }
+};
+
+#endif // MBED_SI7050_CRC_H
@@ -0,0 +1,336 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Filter.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Fixed-point filter stages for raw SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_FILTER_H
+#define MBED_SI7050_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * The filters work on the raw 16 bit temperature code (masked with
+ * SI7050::getRawMask()), before the conversion to temperature. The unused
+ * lower bits of the code keep the fraction, which averaging gains, e.g.
+ * with SI7050Convert::toCentiCelsius(). Every stage has the same interface:
+ *
+ *   bool update(uint16_t in, uint16_t *out)   true if a value was output
+ *   void reset()
+ *
+ * so stages can be combined with SI7050FilterChain. Nothing is allocated.
+ */
+
+/** SI7050Oversample class
+ *
+ *  Average blocks of N samples and output one value per block
+ *  (decimation by N). O(1) per sample.
+ *
+ * @tparam  N   oversampling factor, a power of two up to 65536
+ */
+template<unsigned N>
+class SI7050Oversample
+{
+    static_assert(N >= 1 && N <= 65536 && (N & (N - 1)) == 0, "factor must be a power of two");
+
+public:
+
+    SI7050Oversample() : sum(0), count(0) {}
+
+    /** Add a sample
+     *
+     * @param in    raw value
+     * @param out   storage for the average of the block
+     * @return      true at the end of a block
+     */
+    bool update(uint16_t in, uint16_t *out) {
+        sum += in;
+        if (++count < N) {
+            return false;
+        }
+        *out = (uint16_t) ((sum + N / 2) / N);
+        sum = 0;
+        count = 0;
+        return true;
+    }
+
+    void reset() {
+        sum = 0;
+        count = 0;
+    }
+
+private:
+    uint32_t    sum;
+    unsigned    count;
+};
+
+
+/** SI7050Ema class
+ *
+ *  Exponential moving average with alpha = 1 / 2^SHIFT, computed with
+ *  shifts only. The state keeps SHIFT fraction bits, so small steps of
+ *  the input are not lost. The first sample initializes the average.
+ *  O(1) per sample, outputs every sample.
+ *
+ * @tparam  SHIFT   smoothing, 1 (alpha 1/2) to 15 (alpha 1/32768)
+ */
+template<unsigned SHIFT>
+class SI7050Ema
+{
+    static_assert(SHIFT >= 1 && SHIFT <= 15, "shift must be 1..15");
+
+public:
+
+    SI7050Ema() : state(0), valid(false) {}
+
+    /** Add a sample
+     *
+     * @param in    raw value
+     * @param out   storage for the average
+     * @return      always true
+     */
+    bool update(uint16_t in, uint16_t *out) {
+        if (!valid) {
+            state = (uint32_t) in << SHIFT;
+            valid = true;
+        } else {
+            // state += in - average, with the rounded average, so a constant
+            // input is output exactly
+            state = state - ((state + HALF) >> SHIFT) + in;
+        }
+        *out = (uint16_t) ((state + HALF) >> SHIFT);
+        return true;
+    }
+
+    void reset() {
+        state = 0;
+        valid = false;
+    }
+
+private:
+    static const uint32_t HALF = 1u << (SHIFT - 1);
+
+    uint32_t    state;      // average << SHIFT
+    bool        valid;
+};
+
+
+/** SI7050Median class
+ *
+ *  Median of the last N samples. The window is split into two heaps: a
+ *  max-heap of the lower half, whose top is the median, and a min-heap of
+ *  the upper half. The heaps hold the slots of the window, so the oldest
+ *  sample is replaced in place by the new one and sifted, O(log N) per
+ *  sample. Until the window is full, the median of the samples so far is
+ *  output (the lower one of an even count).
+ *
+ * @tparam  N   window size, odd
+ */
+template<unsigned N>
+class SI7050Median
+{
+    static_assert(N >= 1 && N <= 255 && (N & 1), "window size must be odd and up to 255");
+
+public:
+
+    SI7050Median() : count(0), oldest(0), lowSize(0), highSize(0) {}
+
+    /** Add a sample
+     *
+     * @param in    raw value
+     * @param out   storage for the median
+     * @return      always true
+     */
+    bool update(uint16_t in, uint16_t *out) {
+        uint8_t slot = (uint8_t) oldest;
+
+        history[slot] = in;
+        if (count < N) {
+            if (lowSize == 0 || in <= history[low[0]]) {
+                push(low, lowSize, LOW, slot);
+            } else {
+                push(high, highSize, HIGH, slot);
+            }
+            count++;
+        } else if (side[slot] == LOW) {
+            // the new sample takes the slot of the oldest one in its heap
+            siftDown(low, lowSize, LOW, siftUp(low, LOW, index[slot]));
+        } else {
+            siftDown(high, highSize, HIGH, siftUp(high, HIGH, index[slot]));
+        }
+
+        // keep the halves ordered and the lower one the larger one
+        if (highSize && history[low[0]] > history[high[0]]) {
+            uint8_t top = low[0];
+            place(low, LOW, 0, high[0]);
+            place(high, HIGH, 0, top);
+            siftDown(low, lowSize, LOW, 0);
+            siftDown(high, highSize, HIGH, 0);
+        }
+        if (lowSize > highSize + 1) {
+            push(high, highSize, HIGH, pop(low, lowSize, LOW));
+        } else if (highSize > lowSize) {
+            push(low, lowSize, LOW, pop(high, highSize, HIGH));
+        }
+        oldest = (oldest + 1) % N;
+
+        *out = history[low[0]];
+        return true;
+    }
+
+    void reset() {
+        count = 0;
+        oldest = 0;
+        lowSize = 0;
+        highSize = 0;
+    }
+
+private:
+    enum { LOW, HIGH };
+    static const unsigned HALF = (N + 1) / 2;
+
+    uint16_t    history[N];     // samples by slot, in order of arrival (ring)
+    uint8_t     low[HALF];      // max-heap of the slots of the lower half
+    uint8_t     high[HALF];     // min-heap of the slots of the upper half
+    uint8_t     side[N];        // heap of a slot
+    uint8_t     index[N];       // position of a slot in its heap
+    unsigned    count;
+    unsigned    oldest;
+    unsigned    lowSize;
+    unsigned    highSize;
+
+    // a slot belongs above b in the heap
+    bool above(int heap, uint8_t a, uint8_t b) const {
+        return heap == LOW ? history[a] > history[b] : history[a] < history[b];
+    }
+
+    void place(uint8_t *heap, int which, unsigned i, uint8_t slot) {
+        heap[i] = slot;
+        side[slot] = (uint8_t) which;
+        index[slot] = (uint8_t) i;
+    }
+
+    unsigned siftUp(uint8_t *heap, int which, unsigned i) {
+        uint8_t slot = heap[i];
+
+        while (i > 0 && above(which, slot, heap[(i - 1) / 2])) {
+            place(heap, which, i, heap[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+        place(heap, which, i, slot);
+        return i;
+    }
+
+    void siftDown(uint8_t *heap, unsigned size, int which, unsigned i) {
+        uint8_t slot = heap[i];
+
+        for (;;) {
+            unsigned child = 2 * i + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && above(which, heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!above(which, heap[child], slot)) {
+                break;
+            }
+            place(heap, which, i, heap[child]);
+            i = child;
+        }
+        place(heap, which, i, slot);
+    }
+
+    void push(uint8_t *heap, unsigned &size, int which, uint8_t slot) {
+        place(heap, which, size, slot);
+        siftUp(heap, which, size++);
+    }
+
+    uint8_t pop(uint8_t *heap, unsigned &size, int which) {
+        uint8_t top = heap[0];
+
+        place(heap, which, 0, heap[--size]);
+        siftDown(heap, size, which, 0);
+        return top;
+    }
+};
+
+
+/** SI7050FilterChain class
+ *
+ *  Feed the output of the first stage into the second one. Chains can be
+ *  nested for more stages.
+ *
+ * @code
+ * // median of 5 against spikes, then 4x decimation, then smoothing
+ * SI7050FilterChain<SI7050Median<5>,
+ *         SI7050FilterChain<SI7050Oversample<4>, SI7050Ema<3> > > filter;
+ *
+ * uint16_t filtered;
+ * if (filter.update(sample.raw & sensor.getRawMask(), &filtered)) {
+ *     int16_t temperature = SI7050Convert::toCentiCelsius(filtered);
+ * }
+ * @endcode
+ *
+ * @tparam  First   first stage
+ * @tparam  Second  second stage
+ */
+template<typename First, typename Second>
+class SI7050FilterChain
+{
+public:
+
+    /** Add a sample
+     *
+     * @param in    raw value
+     * @param out   storage for the output of the second stage
+     * @return      true if the second stage output a value
+     */
+    bool update(uint16_t in, uint16_t *out) {
+        uint16_t value;
+
+        return first.update(in, &value) && second.update(value, out);
+    }
+
+    void reset() {
+        first.reset();
+        second.reset();
+    }
+
+    /** Get the first stage, e.g. to reset it alone */
+    First &getFirst() {
+        return first;
+    }
+
+    /** Get the second stage */
+    Second &getSecond() {
+        return second;
+    }
+
+private:
+    First   first;
+    Second  second;
+};
+
+#endif // MBED_SI7050_FILTER_H
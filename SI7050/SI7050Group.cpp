@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Group.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Scheduler for overlapping measurements of several SI7050 sensors
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Group.h"
+
+SI7050Group::SI7050Group()
+        :
+        count(0),
+        sweepTime(0),
+        maxSweepTime(0),
+        sweeps(0) {
+    /* nothing to do */
+}
+
+int SI7050Group::add(SI7050Device &sensor, SI7050Mux *mux, int channel) {
+    if (count >= SI70_GROUP_MAX_SENSORS) {
+        return -1;
+    }
+
+    members[count].sensor = &sensor;
+    members[count].mux = mux;
+    members[count].channel = channel;
+    members[count].deadline = 0;
+    members[count].status = -1;
+    members[count].pending = false;
+    count++;
+
+    return 0;
+}
+
+int SI7050Group::getCount() const {
+    return count;
+}
+
+int SI7050Group::select(Member &member) {
+    if (member.mux == NULL) {
+        return 0;
+    }
+    return member.mux->select(member.channel);
+}
+
+int SI7050Group::collect(Member &member, char *data) {
+    SI7050Bus &bus = member.sensor->getBus();
+    int ret;
+
+    // wait for the end of the conversion of this sensor
+    int32_t remaining = (int32_t) (member.deadline - bus.readUs());
+    if (remaining > 0) {
+        bus.waitUs((uint32_t) remaining);
+    }
+
+    // the bus stays locked from selecting the channel until the transfer is done,
+    // the sensor is locked first, in the order of the driver
+    for (;;) {
+        {
+            SI7050ScopedLock<SI7050Device> sensorLock(*member.sensor);
+            SI7050ScopedLock<SI7050Bus> lock(bus);
+            if (select(member)) {
+                return -1;
+            }
+            ret = member.sensor->pollResult(data);
+        }
+        if (ret != SI70_NOT_READY) {
+            return ret;
+        }
+        bus.waitUs(SI70_GROUP_POLL_US);
+    }
+}
+
+int SI7050Group::sweep(int *temperatures) {
+    int errors = 0;
+    char data[2];
+
+    if (count == 0) {
+        return 0;
+    }
+
+    SI7050Bus &bus = members[0].sensor->getBus();
+    uint32_t start = bus.readUs();
+
+    // trigger all conversions, in the order the sensors were added
+    for (int i = 0; i < count; i++) {
+        Member &member = members[i];
+        SI7050ScopedLock<SI7050Device> sensorLock(*member.sensor);
+        SI7050ScopedLock<SI7050Bus> lock(member.sensor->getBus());
+
+        member.status = select(member);
+        if (!member.status) {
+            member.status = member.sensor->startMeasurement();
+        }
+        member.deadline = member.sensor->getBus().readUs() + member.sensor->getConversionTime();
+        member.pending = (member.status == 0);
+    }
+
+    // collect the results in the order of their deadlines
+    for (int n = 0; n < count; n++) {
+        int next = -1;
+
+        for (int i = 0; i < count; i++) {
+            if (!members[i].pending) {
+                continue;
+            }
+            if (next < 0 || (int32_t) (members[i].deadline - members[next].deadline) < 0) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+
+        Member &member = members[next];
+        member.pending = false;
+        member.status = collect(member, data);
+        if (!member.status) {
+            temperatures[next] = member.sensor->calcTemperature(data);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (members[i].status) {
+            temperatures[i] = -32768;
+            errors++;
+        }
+    }
+
+    sweepTime = bus.readUs() - start;
+    if (sweepTime > maxSweepTime) {
+        maxSweepTime = sweepTime;
+    }
+    sweeps++;
+
+    return errors;
+}
+
+uint32_t SI7050Group::getSweepTime() const {
+    return sweepTime;
+}
+
+uint32_t SI7050Group::getMaxSweepTime() const {
+    return maxSweepTime;
+}
+
+uint32_t SI7050Group::getSweeps() const {
+    return sweeps;
+}
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Group.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Scheduler for overlapping measurements of several SI7050 sensors
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_GROUP_H
+#define MBED_SI7050_GROUP_H
+
+#include "SI7050.h"
+#include "SI7050Mux.h"
+
+#define SI70_GROUP_MAX_SENSORS  8
+#define SI70_GROUP_POLL_US      200     // poll interval, if a sensor is late
+
+/** SI7050Group class
+ *
+ *  Measure several sensors with overlapping conversions: all sensors are
+ *  triggered first, then the results are collected as soon as the
+ *  conversion of each sensor is done. A sweep takes about one conversion
+ *  time plus the transfer time, instead of one conversion time per sensor.
+ *  Sensors behind a multiplexer are selected before each access.
+ *
+ * @note    the buses of all sensors have to share the same time base
+ *
+ * @code
+ * I2C i2c(I2C_SDA, I2C_SCL);
+ * SI7050I2CBus bus(i2c);
+ * TCA9548A mux(bus);
+ * SI7050Device sensor0(bus), sensor1(bus);
+ * SI7050Group group;
+ *
+ * group.add(sensor0, &mux, 0);
+ * group.add(sensor1, &mux, 1);
+ * int temperatures[2];
+ * group.sweep(temperatures);
+ * @endcode
+ */
+class SI7050Group
+{
+public:
+
+    SI7050Group();
+
+    /** Add a sensor to the group
+     *
+     * @param sensor    sensor object (instance)
+     * @param mux       (option) multiplexer, the sensor is connected to
+     * @param channel   (option) channel of the multiplexer
+     * @return          (0) if added, (-1) if the group is full
+     */
+    int add(SI7050Device &sensor, SI7050Mux *mux = NULL, int channel = 0);
+
+    /** Get the number of sensors in the group */
+    int getCount() const;
+
+    /** Measure all sensors of the group
+     *
+     * @param temperatures  storage for one temperature per sensor in 0.01°C,
+     *                      (-32768) if the sensor failed
+     * @return              number of failed sensors
+     */
+    int sweep(int *temperatures);
+
+    /** Get the duration of the last sweep in us */
+    uint32_t getSweepTime() const;
+
+    /** Get the longest sweep duration in us */
+    uint32_t getMaxSweepTime() const;
+
+    /** Get the number of sweeps */
+    uint32_t getSweeps() const;
+
+private:
+    struct Member {
+        SI7050Device *sensor;
+        SI7050Mux   *mux;
+        int         channel;
+        uint32_t    deadline;
+        int         status;
+        bool        pending;
+    };
+
+    Member      members[SI70_GROUP_MAX_SENSORS];
+    int         count;
+    uint32_t    sweepTime;
+    uint32_t    maxSweepTime;
+    uint32_t    sweeps;
+
+    int select(Member &member);
+    int collect(Member &member, char *data);
+};
+
+#endif // MBED_SI7050_GROUP_H
@@ -0,0 +1,289 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Log.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Compact block log format for raw samples of the SI7050
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include <string.h>
+
+#include "SI7050Log.h"
+#include "SI7050Crc.h"
+#include "SI7050Varint.h"
+
+static inline uint32_t zigzag(int32_t value) {
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t value) {
+    return (int32_t) (value >> 1) ^ -(int32_t) (value & 1);
+}
+
+static inline void writeLe16(uint8_t *out, uint16_t value) {
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) (value >> 8);
+}
+
+static inline void writeLe32(uint8_t *out, uint32_t value) {
+    writeLe16(out, (uint16_t) value);
+    writeLe16(out + 2, (uint16_t) (value >> 16));
+}
+
+static inline uint16_t readLe16(const uint8_t *in) {
+    return (uint16_t) (in[0] | (in[1] << 8));
+}
+
+static inline uint32_t readLe32(const uint8_t *in) {
+    return readLe16(in) | ((uint32_t) readLe16(in + 2) << 16);
+}
+
+// CRC-32 of the blocks, reflected polynomial of IEEE 802.3, with a table
+// of 16 entries (64 Byte), which is generated at compile time
+struct SI7050LogCrcTable {
+    uint32_t value[16];
+
+    constexpr SI7050LogCrcTable() : value() {
+        for (int i = 0; i < 16; i++) {
+            uint32_t crc = (uint32_t) i;
+            for (int j = 0; j < 4; j++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            value[i] = crc;
+        }
+    }
+};
+
+static constexpr SI7050LogCrcTable crcTable;
+
+static uint32_t crc32(const uint8_t *data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crcTable.value[crc & 0x0F];
+        crc = (crc >> 4) ^ crcTable.value[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// the header is intact and its fields are consistent
+static bool validHeader(const uint8_t *header) {
+    int resolution = header[1] & 0x0F;
+    uint32_t count = readLe16(&header[2]);
+    uint32_t payload = readLe16(&header[4]);
+
+    return header[0] == SI70_LOG_MAGIC && (header[1] >> 4) == SI70_LOG_VERSION
+           && resolution >= 11 && resolution <= 14 && count != 0
+           && payload >= 2 * (count - 1) && payload <= SI70_LOG_MAX_SAMPLE * (count - 1)
+           && SI7050Crc::calc(header, SI70_LOG_HEADER_SIZE - 1) == header[SI70_LOG_HEADER_SIZE - 1];
+}
+
+
+SI7050LogEncoder::SI7050LogEncoder(uint8_t *buffer_, size_t size_, const unsigned char serial[8], int resolution)
+        :
+        buffer(buffer_),
+        size(size_ - SI70_LOG_CRC_SIZE),
+        shift(16 - resolution),
+        length(SI70_LOG_HEADER_SIZE),
+        count(0),
+        lastTimestamp(0),
+        lastDelta(0),
+        lastRaw(0) {
+    if (size > SI70_LOG_HEADER_SIZE + SI70_LOG_MAX_PAYLOAD) {
+        size = SI70_LOG_HEADER_SIZE + SI70_LOG_MAX_PAYLOAD;
+    }
+    buffer[0] = SI70_LOG_MAGIC;
+    buffer[1] = (uint8_t) ((SI70_LOG_VERSION << 4) | resolution);
+    memcpy(&buffer[6], serial, 8);
+}
+
+int SI7050LogEncoder::add(uint32_t timestamp, uint16_t raw) {
+    uint8_t sample[SI70_LOG_MAX_SAMPLE];
+    size_t n;
+
+    raw = (uint16_t) ((raw >> shift) << shift);
+    if (count == 0) {
+        writeLe32(&buffer[14], timestamp);
+        writeLe16(&buffer[18], raw);
+        lastTimestamp = timestamp;
+        lastDelta = 0;
+        lastRaw = raw;
+        count = 1;
+        return 0;
+    }
+
+    // periodic timestamps encode to a zero change of the delta
+    uint32_t delta = timestamp - lastTimestamp;
+    n = SI7050Varint::write(sample, zigzag((int32_t) (delta - lastDelta)));
+    n += SI7050Varint::write(&sample[n], zigzag(((int32_t) raw - (int32_t) lastRaw) >> shift));
+    if (length + n > size || count == 0xFFFF) {
+        return -1;
+    }
+
+    memcpy(&buffer[length], sample, n);
+    length += n;
+    count++;
+    lastTimestamp = timestamp;
+    lastDelta = delta;
+    lastRaw = raw;
+    return 0;
+}
+
+size_t SI7050LogEncoder::finish() {
+    if (count == 0) {
+        return 0;
+    }
+
+    writeLe16(&buffer[2], (uint16_t) count);
+    writeLe16(&buffer[4], (uint16_t) (length - SI70_LOG_HEADER_SIZE));
+    buffer[SI70_LOG_HEADER_SIZE - 1] = SI7050Crc::calc(buffer, SI70_LOG_HEADER_SIZE - 1);
+    writeLe32(&buffer[length], crc32(buffer, length));
+    return length + SI70_LOG_CRC_SIZE;
+}
+
+void SI7050LogEncoder::reset() {
+    length = SI70_LOG_HEADER_SIZE;
+    count = 0;
+}
+
+int SI7050LogEncoder::getCount() const {
+    return count;
+}
+
+size_t SI7050LogEncoder::getLength() const {
+    return length + SI70_LOG_CRC_SIZE;
+}
+
+
+SI7050LogDecoder::SI7050LogDecoder(const uint8_t *data_, size_t length_)
+        :
+        data(data_),
+        length(length_),
+        blockStart(0),
+        blockEnd(0),
+        position(0),
+        skipped(0),
+        remaining(0),
+        shift(0),
+        lastTimestamp(0),
+        lastDelta(0),
+        lastRaw(0) {
+    /* nothing to do */
+}
+
+int SI7050LogDecoder::nextBlock() {
+    const uint8_t *header = &data[blockEnd];
+
+    remaining = 0;
+    if (length - blockEnd < SI70_LOG_HEADER_SIZE) {
+        return SI70_LOG_INCOMPLETE;
+    }
+    if (!validHeader(header)) {
+        return skipBlock();
+    }
+
+    size_t end = blockEnd + SI70_LOG_HEADER_SIZE + readLe16(&header[4]);
+    if (length - blockEnd < end - blockEnd + SI70_LOG_CRC_SIZE) {
+        return SI70_LOG_INCOMPLETE;
+    }
+    if (crc32(header, end - blockEnd) != readLe32(&data[end])) {
+        return skipBlock();
+    }
+
+    blockStart = blockEnd;
+    blockEnd = end + SI70_LOG_CRC_SIZE;
+    position = blockStart + SI70_LOG_HEADER_SIZE;
+    remaining = readLe16(&header[2]);
+    shift = 16 - (header[1] & 0x0F);
+    return SI70_LOG_OK;
+}
+
+int SI7050LogDecoder::skipBlock() {
+    // resynchronize at the next magic Byte, the header is checked by the
+    // next call, the rest of the stream is skipped if there is none
+    const uint8_t *next = (const uint8_t *) memchr(&data[blockEnd + 1], SI70_LOG_MAGIC, length - blockEnd - 1);
+    size_t start = next ? (size_t) (next - data) : length;
+
+    skipped += start - blockEnd;
+    blockEnd = start;
+    return SI70_LOG_CORRUPT;
+}
+
+bool SI7050LogDecoder::readVarint(uint32_t *value) {
+    return SI7050Varint::read(data, &position, blockEnd - SI70_LOG_CRC_SIZE, value);
+}
+
+bool SI7050LogDecoder::next(uint32_t *timestamp, uint16_t *raw) {
+    const uint8_t *header = &data[blockStart];
+    uint32_t deltaChange, rawDelta;
+
+    if (remaining <= 0) {
+        return false;
+    }
+
+    if (remaining == readLe16(&header[2])) {
+        lastTimestamp = readLe32(&header[14]);
+        lastDelta = 0;
+        lastRaw = readLe16(&header[18]);
+    } else {
+        if (!readVarint(&deltaChange) || !readVarint(&rawDelta)) {
+            remaining = 0;
+            return false;
+        }
+        lastDelta += (uint32_t) unzigzag(deltaChange);
+        lastTimestamp += lastDelta;
+        lastRaw = (uint16_t) (lastRaw + ((uint32_t) unzigzag(rawDelta) << shift));
+    }
+
+    remaining--;
+    *timestamp = lastTimestamp;
+    *raw = lastRaw;
+    return true;
+}
+
+void SI7050LogDecoder::setLength(size_t length_) {
+    length = length_;
+}
+
+size_t SI7050LogDecoder::getConsumed() const {
+    return blockEnd;
+}
+
+size_t SI7050LogDecoder::getSkipped() const {
+    return skipped;
+}
+
+const unsigned char *SI7050LogDecoder::getSerial() const {
+    return &data[blockStart + 6];
+}
+
+int SI7050LogDecoder::getResolution() const {
+    return 16 - shift;
+}
+
+int SI7050LogDecoder::getCount() const {
+    return readLe16(&data[blockStart + 2]);
+}
+
+uint32_t SI7050LogDecoder::getTimestampBase() const {
+    return readLe32(&data[blockStart + 14]);
+}
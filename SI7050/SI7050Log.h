@@ -0,0 +1,223 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Log.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Compact block log format for raw samples of the SI7050
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_LOG_H
+#define MBED_SI7050_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Block layout (multi Byte values little endian):
+ *
+ *   0  magic (SI70_LOG_MAGIC)
+ *   1  version (high nibble) and resolution in bits (low nibble)
+ *   2  number of samples (2 Bytes)
+ *   4  payload length (2 Bytes)
+ *   6  serial of the sensor (8 Bytes)
+ *  14  timestamp of the first sample in us (4 Bytes)
+ *  18  raw value of the first sample (2 Bytes)
+ *  20  CRC-8 (SI7050Crc) of the header, Bytes 0 to 19
+ *  21  payload: for every further sample, the zigzag varint of the change
+ *      of the timestamp delta, then the zigzag varint of the raw delta in
+ *      steps of the resolution
+ *   n  CRC-32 (IEEE 802.3, as zlib crc32()) over header and payload (4 Bytes)
+ *
+ * The header CRC lets the decoder find the next block after a corrupted
+ * one, the CRC-32 protects blocks up to the maximum payload of 64 kB.
+ */
+#define SI70_LOG_MAGIC          0x57
+#define SI70_LOG_VERSION        2
+#define SI70_LOG_HEADER_SIZE    21
+#define SI70_LOG_CRC_SIZE       4
+#define SI70_LOG_MAX_SAMPLE     8       // maximum encoded size of a sample (5 + 3 Bytes)
+#define SI70_LOG_MAX_PAYLOAD    0xFFFF
+
+// return values of the decoder
+#define SI70_LOG_OK             0
+#define SI70_LOG_CORRUPT        (-1)    // wrong header or CRC, skipped to the next block
+#define SI70_LOG_INCOMPLETE     1       // the block is not complete yet, feed more data
+
+/** SI7050LogEncoder class
+ *
+ *  Encode raw samples of one sensor into a block. The caller owns the
+ *  buffer, which is the maximum block size.
+ *
+ * @code
+ * uint8_t block[256];
+ * SI7050LogEncoder encoder(block, sizeof(block), serial, 14);
+ *
+ * if (encoder.add(timestamp, raw)) {
+ *     send(block, encoder.finish());
+ *     encoder.reset();
+ *     encoder.add(timestamp, raw);
+ * }
+ * @endcode
+ */
+class SI7050LogEncoder
+{
+public:
+
+    /** Create an encoder
+     *
+     * @param buffer        storage for the block
+     * @param size          size of the storage, at least the header, the
+     *                      CRC and one sample
+     * @param serial        serial number of the sensor (8 Bytes)
+     * @param resolution    resolution in bits (11, 12, 13 or 14)
+     */
+    SI7050LogEncoder(uint8_t *buffer, size_t size, const unsigned char serial[8], int resolution);
+
+    /** Add a sample to the block
+     *
+     * @param timestamp     time of the sample in us
+     * @param raw           raw 16 bit temperature code
+     * @return              (0) if added, (-1) if the block is full
+     */
+    int add(uint32_t timestamp, uint16_t raw);
+
+    /** Complete the block with the header fields and the CRC
+     *
+     * @return              length of the block, (0) if the block is empty
+     */
+    size_t finish();
+
+    /** Start a new block in the buffer */
+    void reset();
+
+    /** Get the number of samples in the block */
+    int getCount() const;
+
+    /** Get the length of the block including the CRC */
+    size_t getLength() const;
+
+private:
+    uint8_t     *buffer;
+    size_t      size;
+    int         shift;
+    size_t      length;
+    int         count;
+    uint32_t    lastTimestamp;
+    uint32_t    lastDelta;
+    uint16_t    lastRaw;
+};
+
+
+/** SI7050LogDecoder class
+ *
+ *  Streaming decoder of a sequence of blocks. The data is not copied: the
+ *  decoder reads the samples lazily from the buffer of the caller and the
+ *  serial points into it.
+ *
+ *  A corrupted block is skipped: the decoder searches the next magic
+ *  Byte, which starts a valid header, and continues there, so the blocks
+ *  behind it are not lost.
+ *
+ * @code
+ * SI7050LogDecoder decoder(data, length);
+ * int ret;
+ * while ((ret = decoder.nextBlock()) != SI70_LOG_INCOMPLETE) {
+ *     if (ret == SI70_LOG_CORRUPT) {
+ *         continue;   // see getSkipped()
+ *     }
+ *     while (decoder.next(&timestamp, &raw)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+class SI7050LogDecoder
+{
+public:
+
+    /** Create a decoder
+     *
+     * @param data      stream of blocks
+     * @param length    number of Bytes in the stream
+     */
+    SI7050LogDecoder(const uint8_t *data, size_t length);
+
+    /** Open the next block of the stream and check its CRCs
+     *
+     * @return          SI70_LOG_OK, SI70_LOG_INCOMPLETE if the stream ends
+     *                  inside the block (or before it), SI70_LOG_CORRUPT if
+     *                  the block is broken, the next call continues at the
+     *                  next magic Byte behind its start
+     */
+    int nextBlock();
+
+    /** Decode the next sample of the current block
+     *
+     * @param timestamp storage for the time of the sample in us
+     * @param raw       storage for the raw 16 bit temperature code
+     * @return          false if the block has no more samples
+     */
+    bool next(uint32_t *timestamp, uint16_t *raw);
+
+    /** Extend the stream, e.g. after more data was received into the same
+     *  buffer (the data, which was read, has to stay in place)
+     *
+     * @param length    new number of Bytes in the stream
+     */
+    void setLength(size_t length);
+
+    /** Get the number of Bytes of the stream, which were consumed by complete
+     *  or skipped blocks */
+    size_t getConsumed() const;
+
+    /** Get the number of Bytes, which were skipped because of corruption */
+    size_t getSkipped() const;
+
+    /** Get the serial number of the current block (8 Bytes, in the stream) */
+    const unsigned char *getSerial() const;
+
+    /** Get the resolution of the current block in bits */
+    int getResolution() const;
+
+    /** Get the number of samples of the current block */
+    int getCount() const;
+
+    /** Get the timestamp of the first sample of the current block */
+    uint32_t getTimestampBase() const;
+
+private:
+    const uint8_t   *data;
+    size_t          length;
+    size_t          blockStart;
+    size_t          blockEnd;
+    size_t          position;
+    size_t          skipped;
+    int             remaining;
+    int             shift;
+    uint32_t        lastTimestamp;
+    uint32_t        lastDelta;
+    uint16_t        lastRaw;
+
+    bool readVarint(uint32_t *value);
+    int skipBlock();
+};
+
+#endif // MBED_SI7050_LOG_H
@@ -0,0 +1,230 @@
+/**
+ ******************************************************************************
+ * @file    SI7050MultiBus.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Synchronized measurements of sensors on several I2C buses
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include <new>
+#include <string.h>
+
+#include "SI7050MultiBus.h"
+
+#if !defined(__MBED__) || defined(MBED_CONF_RTOS_PRESENT)
+
+#ifndef __MBED__
+#include <chrono>
+#endif
+
+SI7050MultiBus::SI7050MultiBus()
+        :
+        sensorCount(0),
+        workerCount(0),
+        running(false),
+        frame(),
+        maxSkew(0),
+        frames(0) {
+    /* nothing to do */
+}
+
+SI7050MultiBus::~SI7050MultiBus() {
+    stop();
+}
+
+uint32_t SI7050MultiBus::readUs() {
+#ifdef __MBED__
+    return us_ticker_read();
+#else
+    return (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+int SI7050MultiBus::add(SI7050Device &sensor) {
+    SI7050Bus *bus = &sensor.getBus();
+    int w;
+
+    if (running || sensorCount >= SI70_MULTI_MAX_SENSORS) {
+        return -1;
+    }
+
+    for (w = 0; w < workerCount && workers[w].bus != bus; w++);
+    if (w == workerCount) {
+        if (workerCount >= SI70_MULTI_MAX_BUSES) {
+            return -1;
+        }
+        workers[w].owner = this;
+        workers[w].bus = bus;
+        workers[w].count = 0;
+        workerCount++;
+    }
+
+    workers[w].sensors[workers[w].count++] = sensorCount;
+    sensors[sensorCount] = &sensor;
+    return sensorCount++;
+}
+
+int SI7050MultiBus::start() {
+    if (running) {
+        return 0;
+    }
+    if (sensorCount == 0) {
+        return -1;
+    }
+
+    // the workers and the caller of capture()
+    barrier.setParties(workerCount + 1);
+    running = true;
+    for (int w = 0; w < workerCount; w++) {
+#ifdef __MBED__
+        workers[w].thread = new(workers[w].threadStorage) rtos::Thread(
+                osPriorityAboveNormal, sizeof(workers[w].stack), (unsigned char *) workers[w].stack);
+        workers[w].thread->start(mbed::callback(&SI7050MultiBus::run, &workers[w]));
+#else
+        workers[w].thread = std::thread(&SI7050MultiBus::run, &workers[w]);
+#endif
+    }
+
+    return 0;
+}
+
+void SI7050MultiBus::stop() {
+    if (!running) {
+        return;
+    }
+
+    // release the workers, they see running cleared and end
+    running = false;
+    barrier.wait();
+    for (int w = 0; w < workerCount; w++) {
+#ifdef __MBED__
+        workers[w].thread->join();
+        workers[w].thread->~Thread();
+#else
+        workers[w].thread.join();
+#endif
+    }
+}
+
+void SI7050MultiBus::run(Worker *worker) {
+    SI7050MultiBus *owner = worker->owner;
+
+    for (;;) {
+        owner->barrier.wait();
+        if (!owner->running) {
+            return;
+        }
+        owner->measure(*worker);
+        owner->barrier.wait();
+    }
+}
+
+void SI7050MultiBus::measure(Worker &worker) {
+    SI7050Bus &bus = *worker.bus;
+    uint32_t deadlines[SI70_MULTI_MAX_SENSORS];
+    char data[2];
+
+    // start all conversions of this bus back to back
+    for (int i = 0; i < worker.count; i++) {
+        SI7050Sample &sample = frame.samples[worker.sensors[i]];
+        SI7050Device &sensor = *sensors[worker.sensors[i]];
+
+        sample.status = sensor.startMeasurement() ? SI70_SAMPLE_ERROR : SI70_SAMPLE_OK;
+        sample.timestamp = readUs();
+        sample.raw = 0;
+        deadlines[i] = bus.readUs() + sensor.getConversionTime();
+    }
+
+    // collect the results in the order of the starts
+    for (int i = 0; i < worker.count; i++) {
+        SI7050Sample &sample = frame.samples[worker.sensors[i]];
+        SI7050Device &sensor = *sensors[worker.sensors[i]];
+        int ret;
+
+        if (sample.status != SI70_SAMPLE_OK) {
+            continue;
+        }
+        int32_t remaining = (int32_t) (deadlines[i] - bus.readUs());
+        if (remaining > 0) {
+            bus.waitUs((uint32_t) remaining);
+        }
+        while ((ret = sensor.pollResult(data)) == SI70_NOT_READY) {
+            bus.waitUs(SI70_MULTI_POLL_US);
+        }
+        if (ret) {
+            sample.status = ret == SI70_ERROR_CRC ? SI70_SAMPLE_CRC : SI70_SAMPLE_ERROR;
+        } else {
+            sample.raw = (uint16_t) (((unsigned char) data[0] << 8) | (unsigned char) data[1]);
+        }
+    }
+}
+
+int SI7050MultiBus::capture(SI7050Frame *result) {
+    if (!running) {
+        return -1;
+    }
+
+    frame.timestamp = readUs();
+    barrier.wait();     // release the conversion starts
+    barrier.wait();     // all results are collected
+
+    uint32_t first = 0, last = 0;
+    bool any = false;
+    frame.count = sensorCount;
+    frame.errors = 0;
+    for (int i = 0; i < sensorCount; i++) {
+        const SI7050Sample &sample = frame.samples[i];
+        if (sample.status != SI70_SAMPLE_OK) {
+            frame.errors++;
+            continue;
+        }
+        if (!any || (int32_t) (sample.timestamp - first) < 0) {
+            first = sample.timestamp;
+        }
+        if (!any || (int32_t) (sample.timestamp - last) > 0) {
+            last = sample.timestamp;
+        }
+        any = true;
+    }
+    frame.skewUs = last - first;
+    if (frame.skewUs > maxSkew) {
+        maxSkew = frame.skewUs;
+    }
+    frames++;
+
+    memcpy(result, &frame, sizeof(frame));
+    return frame.errors;
+}
+
+int SI7050MultiBus::getBuses() const {
+    return workerCount;
+}
+
+uint32_t SI7050MultiBus::getMaxSkew() const {
+    return maxSkew;
+}
+
+uint32_t SI7050MultiBus::getFrames() const {
+    return frames;
+}
+
+#endif
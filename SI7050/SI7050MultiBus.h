@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @file    SI7050MultiBus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Synchronized measurements of sensors on several I2C buses
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_MULTI_BUS_H
+#define MBED_SI7050_MULTI_BUS_H
+
+#include "SI7050.h"
+
+#if !defined(__MBED__) || defined(MBED_CONF_RTOS_PRESENT)
+
+#ifndef __MBED__
+#include <thread>
+#endif
+
+#define SI70_MULTI_MAX_BUSES    4
+#define SI70_MULTI_MAX_SENSORS  8
+#define SI70_MULTI_POLL_US      200     // poll interval, if a sensor is late
+#define SI70_MULTI_STACK_SIZE   1024    // stack of a worker thread on mbed
+
+/** Time-aligned measurement of all sensors of a SI7050MultiBus */
+struct SI7050Frame {
+    uint32_t        timestamp;      // release of the conversion starts in us
+    uint32_t        skewUs;         // time between the first and the last conversion start
+    int             count;          // number of sensors
+    int             errors;         // number of failed sensors
+    SI7050Sample    samples[SI70_MULTI_MAX_SENSORS];   // the timestamp is the conversion start
+};
+
+/** SI7050MultiBus class
+ *
+ *  Measure sensors on different I2C buses at the same instant. Each bus
+ *  has a worker thread, which starts the conversions of its sensors, as
+ *  soon as all workers are released by a shared barrier, and collects the
+ *  results into one frame. The start-time skew between the sensors is
+ *  reported per frame. The sensors of one bus are started one after the
+ *  other, so their skew is the transfer time of the start command.
+ *
+ *  The timestamps of the frame are taken from a common time base (the us
+ *  ticker on mbed, the steady clock on the host), not from the buses.
+ *
+ * @note    needs the rtos on mbed
+ *
+ * @code
+ * SI7050 sensor0(I2C_SDA0, I2C_SCL0), sensor1(I2C_SDA1, I2C_SCL1);
+ * SI7050MultiBus multi;
+ *
+ * multi.add(sensor0);
+ * multi.add(sensor1);
+ * multi.start();
+ * SI7050Frame frame;
+ * multi.capture(&frame);
+ * @endcode
+ */
+class SI7050MultiBus
+{
+public:
+
+    SI7050MultiBus();
+
+    /** Stop the workers */
+    ~SI7050MultiBus();
+
+    /** Add a sensor, sensors with the same bus object share a worker
+     *
+     * @param sensor    sensor object (instance)
+     * @return          index of the sensor in the frame, (-1) if there
+     *                  are too many sensors or buses, or the workers run
+     */
+    int add(SI7050Device &sensor);
+
+    /** Start the worker threads
+     *
+     * @return          (0) if started, (-1) if there is no sensor
+     */
+    int start();
+
+    /** Stop the worker threads */
+    void stop();
+
+    /** Measure all sensors synchronously
+     *
+     * @param frame     storage for the results
+     * @return          number of failed sensors, (-1) if not started
+     */
+    int capture(SI7050Frame *frame);
+
+    /** Get the number of buses (workers) */
+    int getBuses() const;
+
+    /** Get the largest skew of all frames in us */
+    uint32_t getMaxSkew() const;
+
+    /** Get the number of frames */
+    uint32_t getFrames() const;
+
+    /** Read the common time base in us */
+    static uint32_t readUs();
+
+private:
+    struct Worker {
+        SI7050MultiBus  *owner;
+        SI7050Bus       *bus;
+        int             sensors[SI70_MULTI_MAX_SENSORS];
+        int             count;
+#ifdef __MBED__
+        alignas(rtos::Thread) unsigned char threadStorage[sizeof(rtos::Thread)];
+        uint64_t        stack[SI70_MULTI_STACK_SIZE / sizeof(uint64_t)];
+        rtos::Thread    *thread;
+#else
+        std::thread     thread;
+#endif
+    };
+
+    SI7050Device    *sensors[SI70_MULTI_MAX_SENSORS];
+    int             sensorCount;
+    Worker          workers[SI70_MULTI_MAX_BUSES];
+    int             workerCount;
+    SI7050Barrier   barrier;
+    bool            running;        // written before the barrier is released
+    SI7050Frame     frame;
+    uint32_t        maxSkew;
+    uint32_t        frames;
+
+    static void run(Worker *worker);
+    void measure(Worker &worker);
+};
+
+#endif
+
+#endif // MBED_SI7050_MULTI_BUS_H
@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Mux.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   I2C multiplexer implementation
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Mux.h"
+
+TCA9548A::TCA9548A(SI7050Bus &bus_obj, char slave_adr)
+        :
+        bus(bus_obj),
+        address(slave_adr),
+        channel(-1),
+        switches(0) {
+    /* nothing to do */
+}
+
+int TCA9548A::select(int channel_) {
+    if (channel_ < 0 || channel_ >= TCA9548A_CHANNELS) {
+        return -1;
+    }
+    if (channel_ == channel) {
+        return 0;
+    }
+
+    // one bit per channel in the control register
+    if (writeControl((char) (1 << channel_))) {
+        return -1;
+    }
+    channel = channel_;
+
+    return 0;
+}
+
+int TCA9548A::deselect() {
+    int ret = writeControl(0);
+
+    channel = -1;
+    return ret;
+}
+
+uint32_t TCA9548A::getSwitches() const {
+    return switches;
+}
+
+int TCA9548A::writeControl(char control) {
+    switches++;
+    int ret = bus.write(address, &control, 1, false);
+    if (ret) {
+        channel = -1;   // unknown state of the multiplexer
+    }
+    return ret;
+}
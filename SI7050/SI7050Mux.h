@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Mux.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   I2C multiplexer interface for several SI7050 sensors on one bus
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_MUX_H
+#define MBED_SI7050_MUX_H
+
+#include "SI7050Bus.h"
+
+#define TCA9548A_ADDRESS    (0x70 << 1)
+#define TCA9548A_CHANNELS   8
+
+/** SI7050Mux class
+ *
+ *  Interface of an I2C multiplexer, which connects one of its channels to
+ *  the bus. The SI7050 has a fixed address, so several sensors on one bus
+ *  have to be placed behind a multiplexer.
+ */
+class SI7050Mux
+{
+public:
+
+    virtual ~SI7050Mux() {}
+
+    /** Connect a channel to the bus
+     *
+     * @param channel   channel number
+     * @return          (0) if no error, none (0) if error
+     */
+    virtual int select(int channel) = 0;
+};
+
+/** TCA9548A class
+ *
+ *  8 channel I2C multiplexer TCA9548A (and compatible, e.g. PCA9548A).
+ *  The selected channel is cached, so selecting the same channel again
+ *  does not access the bus.
+ */
+class TCA9548A : public SI7050Mux
+{
+public:
+
+    /** Create a TCA9548A instance
+     *
+     * @param bus_obj bus object (instance)
+     * @param slave_adr (option) I2C-bus address (default: 0x70)
+     */
+    explicit TCA9548A(SI7050Bus &bus_obj, char slave_adr = (char) TCA9548A_ADDRESS);
+
+    virtual int select(int channel);
+
+    /** Disconnect all channels from the bus
+     *
+     * @return          (0) if no error, none (0) if error
+     */
+    int deselect();
+
+    /** Get the number of channel switches on the bus */
+    uint32_t getSwitches() const;
+
+private:
+    SI7050Bus   &bus;
+    char        address;
+    int         channel;
+    uint32_t    switches;
+
+    int writeControl(char control);
+};
+
+#endif // MBED_SI7050_MUX_H
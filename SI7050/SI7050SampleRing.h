@@ -0,0 +1,174 @@
+/**
+ ******************************************************************************
+ * @file    SI7050SampleRing.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Lock-free ring buffer for timestamped SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_SAMPLE_RING_H
+#define MBED_SI7050_SAMPLE_RING_H
+
+#include <atomic>
+
+#include "SI7050.h"
+
+/** Contiguous part of the ring buffer */
+struct SI7050SampleSpan {
+    const SI7050Sample  *data;
+    size_t              length;
+};
+
+/** SI7050SampleRing class
+ *
+ *  Fixed capacity single-producer/single-consumer ring buffer without heap
+ *  and without locks. The producer (e.g. a periodic sampler in an
+ *  interrupt or thread) pushes, the consumer drains single samples or
+ *  blocks of contiguous samples. If several readers need the samples,
+ *  either one consumer forwards them, or the producer pushes into one
+ *  ring per reader.
+ *  Only loads and stores of the indices are atomic, so no atomic
+ *  read-modify-write is needed, which is also lock-free on Cortex-M0.
+ *
+ * @tparam  N   capacity, a power of two
+ *
+ * @code
+ * SI7050SampleRing<64> ring;
+ *
+ * // producer
+ * SI7050Sample sample;
+ * sensor.measureSample(&sample);
+ * ring.push(sample);
+ *
+ * // consumer
+ * SI7050SampleSpan spans[2];
+ * int n = ring.peek(spans);
+ * for (int i = 0; i < n; i++) {
+ *     log(spans[i].data, spans[i].length);
+ *     ring.consume(spans[i].length);
+ * }
+ * @endcode
+ */
+template<size_t N>
+class SI7050SampleRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+
+    SI7050SampleRing() : head(0), tail(0), overruns(0) {}
+
+    /** Push a sample (producer only)
+     *
+     * @param sample    sample to store
+     * @return          true if stored, false if the ring is full (overrun)
+     */
+    bool push(const SI7050Sample &sample) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+
+        if (h - tail.load(std::memory_order_acquire) >= N) {
+            overruns++;
+            return false;
+        }
+        buffer[h & (N - 1)] = sample;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Pop the oldest sample (consumer only)
+     *
+     * @param sample    storage for the sample
+     * @return          true if a sample was read, false if the ring is empty
+     */
+    bool pop(SI7050Sample &sample) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        sample = buffer[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Get the stored samples as contiguous blocks, without removing them
+     *  (consumer only)
+     *
+     * @param spans     storage for up to two blocks, the second one is used,
+     *                  if the samples wrap around the end of the buffer
+     * @return          number of blocks (0, 1 or 2)
+     */
+    int peek(SI7050SampleSpan spans[2]) const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t count = head.load(std::memory_order_acquire) - t;
+        size_t start = t & (N - 1);
+
+        if (count == 0) {
+            return 0;
+        }
+        spans[0].data = &buffer[start];
+        if (start + count <= N) {
+            spans[0].length = count;
+            return 1;
+        }
+        spans[0].length = N - start;
+        spans[1].data = &buffer[0];
+        spans[1].length = count - spans[0].length;
+        return 2;
+    }
+
+    /** Remove samples after processing them with peek() (consumer only)
+     *
+     * @param count     number of samples to remove
+     */
+    void consume(size_t count) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t available = head.load(std::memory_order_acquire) - t;
+
+        if (count > available) {
+            count = available;
+        }
+        tail.store(t + (uint32_t) count, std::memory_order_release);
+    }
+
+    /** Get the number of stored samples */
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    /** Get the capacity of the ring */
+    static size_t capacity() {
+        return N;
+    }
+
+    /** Get the number of samples, which were lost because the ring was full */
+    uint32_t getOverruns() const {
+        return overruns;
+    }
+
+private:
+    SI7050Sample            buffer[N];
+    std::atomic<uint32_t>   head;       // written by the producer only
+    std::atomic<uint32_t>   tail;       // written by the consumer only
+    uint32_t                overruns;   // written by the producer only
+};
+
+#endif // MBED_SI7050_SAMPLE_RING_H
@@ -0,0 +1,282 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Sampler.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Periodic sampler of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include <string.h>
+
+#include "SI7050Sampler.h"
+
+SI7050Sampler::SI7050Sampler(SI7050Device &sensor_obj, uint32_t periodUs, SI7050SampleCallback callback_, void *context_)
+        :
+        sensor(sensor_obj),
+        period(periodUs),
+        callback(callback_),
+        context(context_),
+        state(STOPPED),
+        deadline(0),
+        interval(periodUs),
+        startTime(0),
+        stats(),
+        adaptive(),
+        bandRaw(0),
+        anchor(0),
+        anchored(false),
+        stable(0),
+        fineBits(0)
+#ifdef __MBED__
+        , queue(NULL)
+#endif
+{
+    /* nothing to do */
+}
+
+int SI7050Sampler::start() {
+    if (period < getMinPeriod()) {
+        return -1;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    deadline = sensor.getBus().readUs();
+    startTime = deadline;
+    interval = period;
+    anchored = false;
+    stable = 0;
+    fineBits = sensor.getResolution();
+    state = WAITING;
+
+    return 0;
+}
+
+#ifdef __MBED__
+int SI7050Sampler::start(EventQueue &queue_) {
+    if (start()) {
+        return -1;
+    }
+
+    queue = &queue_;
+    queue->call(this, &SI7050Sampler::onEvent);
+
+    return 0;
+}
+
+void SI7050Sampler::onTimeout() {
+    // interrupt context: the bus is accessed from the thread of the queue
+    queue->call(this, &SI7050Sampler::onEvent);
+}
+
+void SI7050Sampler::onEvent() {
+    uint32_t us = process();
+
+    if (state != STOPPED) {
+        timeout.attach_us(mbed::callback(this, &SI7050Sampler::onTimeout), us);
+    }
+}
+#endif
+
+void SI7050Sampler::stop() {
+#ifdef __MBED__
+    timeout.detach();
+#endif
+    if (state == CONVERTING) {
+        // collect the conversion, so the sensor is not left with a pending result
+        char data[2];
+        while (sensor.pollResult(data) == SI70_NOT_READY) {
+            sensor.getBus().waitUs(SI70_SAMPLER_POLL_US);
+        }
+    }
+    state = STOPPED;
+}
+
+bool SI7050Sampler::isRunning() const {
+    return state != STOPPED;
+}
+
+uint32_t SI7050Sampler::untilDeadline() {
+    int32_t remaining = (int32_t) (deadline - sensor.getBus().readUs());
+
+    return remaining > 0 ? (uint32_t) remaining : 0;
+}
+
+uint32_t SI7050Sampler::process() {
+    SI7050Bus &bus = sensor.getBus();
+    char data[2];
+
+    switch (state) {
+        case WAITING: {
+            uint32_t late = bus.readUs() - deadline;
+
+            if ((int32_t) late < 0) {
+                return untilDeadline();
+            }
+
+            // skip the deadlines, which can not be met anymore
+            if (late >= interval) {
+                uint32_t skipped = late / interval;
+                stats.missed += skipped;
+                deadline += skipped * interval;
+                late -= skipped * interval;
+            }
+
+            stats.jitterUs = late;
+            stats.sumJitterUs += late;
+            if (late > stats.maxJitterUs) {
+                stats.maxJitterUs = late;
+            }
+
+            if (sensor.startMeasurement()) {
+                deliver(-1, NULL);
+                return untilDeadline();
+            }
+            state = CONVERTING;
+            return sensor.getConversionTime();
+        }
+
+        case CONVERTING: {
+            int ret = sensor.pollResult(data);
+
+            if (ret == SI70_NOT_READY) {
+                return SI70_SAMPLER_POLL_US;
+            }
+            deliver(ret, data);
+            return untilDeadline();
+        }
+
+        default:
+            return period;
+    }
+}
+
+void SI7050Sampler::deliver(int status, const char *data) {
+    SI7050Sample sample;
+
+    sample.timestamp = deadline;
+    sample.raw = 0;
+    switch (status) {
+        case 0:
+            sample.raw = (uint16_t) (((unsigned char) data[0] << 8) | (unsigned char) data[1]);
+            sample.status = SI70_SAMPLE_OK;
+            break;
+        case SI70_ERROR_CRC:
+            sample.status = SI70_SAMPLE_CRC;
+            break;
+        default:
+            sample.status = SI70_SAMPLE_ERROR;
+            break;
+    }
+
+    stats.samples++;
+    stats.baseline = (deadline - startTime) / period + 1;
+    if (sample.status != SI70_SAMPLE_OK) {
+        stats.errors++;
+    } else if (adaptive.maxPeriodUs) {
+        adapt(sample.raw);
+    }
+
+    state = WAITING;
+    deadline += interval;
+    if (callback != NULL) {
+        callback(context, &sample);
+    }
+}
+
+int SI7050Sampler::setPeriod(uint32_t periodUs) {
+    if (periodUs < getMinPeriod()) {
+        return -1;
+    }
+    period = periodUs;
+    if (!adaptive.maxPeriodUs || interval < period) {
+        interval = period;
+    }
+    return 0;
+}
+
+uint32_t SI7050Sampler::getPeriod() const {
+    return period;
+}
+
+uint32_t SI7050Sampler::getMinPeriod() const {
+    return sensor.getConversionTime() + SI70_SAMPLER_MARGIN_US;
+}
+
+const SI7050SamplerStats &SI7050Sampler::getStats() const {
+    return stats;
+}
+
+int SI7050Sampler::setAdaptivePolicy(const SI7050AdaptivePolicy &policy) {
+    if (state != STOPPED) {
+        return -1;
+    }
+    if (policy.maxPeriodUs && (policy.bandCentiCelsius < 0 || policy.stableSamples < 1
+                               || (policy.coarseBits && (policy.coarseBits < 11 || policy.coarseBits > 14)))) {
+        return -1;
+    }
+
+    adaptive = policy;
+    // 1 raw code is 17572 / 65536 of 0.01°C
+    bandRaw = (uint32_t) (((uint64_t) policy.bandCentiCelsius << 16) / 17572);
+    return 0;
+}
+
+const SI7050AdaptivePolicy &SI7050Sampler::getAdaptivePolicy() const {
+    return adaptive;
+}
+
+uint32_t SI7050Sampler::getInterval() const {
+    return interval;
+}
+
+void SI7050Sampler::adapt(uint16_t raw) {
+    uint16_t value = (uint16_t) (raw & sensor.getRawMask());
+    uint32_t change = value > anchor ? value - anchor : anchor - value;
+
+    if (!anchored || change > bandRaw) {
+        // a change: back to the period and the fine resolution at once
+        anchor = value;
+        anchored = true;
+        stable = 0;
+        if (interval != period) {
+            interval = period;
+            setCoarse(false);
+        }
+        return;
+    }
+
+    if (++stable < adaptive.stableSamples || interval >= adaptive.maxPeriodUs) {
+        return;
+    }
+    stable = 0;
+    if (interval == period) {
+        setCoarse(true);
+    }
+    interval = interval > adaptive.maxPeriodUs / 2 ? adaptive.maxPeriodUs : 2 * interval;
+}
+
+void SI7050Sampler::setCoarse(bool coarse) {
+    int bits = coarse ? adaptive.coarseBits : fineBits;
+
+    if (adaptive.coarseBits && adaptive.coarseBits != fineBits && sensor.setResolution(bits) == 0) {
+        stats.resolutionChanges++;
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Sampler.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Periodic sampler of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_SAMPLER_H
+#define MBED_SI7050_SAMPLER_H
+
+#include "SI7050.h"
+
+#define SI70_SAMPLER_POLL_US    200     // poll interval, if the conversion is late
+#define SI70_SAMPLER_MARGIN_US  500     // minimum period is the conversion time plus this margin
+
+/** Sample callback of the sampler
+ *
+ * @param context   user context, which was given to the sampler
+ * @param sample    the sample, the timestamp is the deadline of the sample
+ */
+typedef void (*SI7050SampleCallback)(void *context, const SI7050Sample *sample);
+
+/** Timing statistics of the sampler */
+struct SI7050SamplerStats {
+    uint32_t    samples;        // delivered samples (including failed ones)
+    uint32_t    errors;         // samples with status != SI70_SAMPLE_OK
+    uint32_t    missed;         // deadlines, which passed without a conversion start
+    uint32_t    jitterUs;       // start delay of the last conversion after its deadline
+    uint32_t    maxJitterUs;    // maximum start delay
+    uint64_t    sumJitterUs;    // sum of the start delays, for the mean
+    uint32_t    baseline;       // samples a fixed rate sampler would have taken meanwhile
+    uint32_t    resolutionChanges;  // switches between the fine and the coarse resolution
+};
+
+/** Adaptive sampling policy, see SI7050Sampler::setAdaptivePolicy()
+ *
+ *  While the samples stay within the band around the last change, the
+ *  interval doubles every stableSamples samples, up to maxPeriodUs. A
+ *  sample outside the band returns to the period of the sampler at once.
+ *  The default (all zero) samples at the fixed period.
+ */
+struct SI7050AdaptivePolicy {
+    int         bandCentiCelsius;   // change in 0.01°C, which still counts as flat
+    int         stableSamples;      // flat samples, before the interval doubles (at least 1)
+    uint32_t    maxPeriodUs;        // longest interval, (0) disables the adaptive mode
+    int         coarseBits;         // resolution while the interval is longer than the
+                                    // period (11..14), (0) keeps the resolution; the band
+                                    // should be wider than its step
+};
+
+/** SI7050Sampler class
+ *
+ *  Start conversions on absolute deadlines (start + n * period), so the
+ *  sample timing does not drift by the measurement time, and deliver the
+ *  samples to a callback. If a deadline can not be met, it is skipped and
+ *  counted as missed.
+ *
+ *  The sampler is driven by process(), which does the work, which is due,
+ *  and returns the time until it has to be called again. On mbed, start()
+ *  with an EventQueue drives it by a Timeout, which dispatches process()
+ *  to the queue, so the bus is accessed from thread context.
+ *
+ * @code
+ * EventQueue queue;
+ * SI7050 sensor(I2C_SDA, I2C_SCL);
+ * SI7050Sampler sampler(sensor, 100000, sampled);     // 10 Hz
+ *
+ * sampler.start(queue);
+ * queue.dispatch_forever();
+ * @endcode
+ */
+class SI7050Sampler
+{
+public:
+
+    /** Create a sampler
+     *
+     * @param sensor_obj    sensor object (instance)
+     * @param periodUs      sample period in us
+     * @param callback      function to call for every sample
+     * @param context       user context, which is handed to the callback
+     */
+    SI7050Sampler(SI7050Device &sensor_obj, uint32_t periodUs, SI7050SampleCallback callback, void *context = NULL);
+
+    /** Start sampling, the first deadline is now
+     *
+     * @return          (0) if started, (-1) if the period is shorter than
+     *                  the minimum period of the resolution
+     */
+    int start();
+
+#ifdef __MBED__
+    /** Start sampling, driven by a Timeout and the event queue
+     *
+     * @param queue     event queue, which runs process()
+     * @return          (0) if started, (-1) if the period is too short
+     */
+    int start(EventQueue &queue);
+#endif
+
+    /** Stop sampling, a running conversion is discarded */
+    void stop();
+
+    /** Check if the sampler runs */
+    bool isRunning() const;
+
+    /** Do the work, which is due
+     *
+     * @return          time in us, until process() has to be called again
+     */
+    uint32_t process();
+
+    /** Set the sample period, takes effect after the next sample
+     *
+     * @return          (0) if no error, (-1) if the period is too short
+     */
+    int setPeriod(uint32_t periodUs);
+
+    /** Get the sample period in us */
+    uint32_t getPeriod() const;
+
+    /** Get the minimum period for the resolution of the sensor in us */
+    uint32_t getMinPeriod() const;
+
+    /** Set the adaptive sampling policy, while the sampler is stopped
+     *
+     * @param policy    the policy, the default (all zero) disables it
+     * @return          (0) if no error, (-1) if running or the policy is invalid
+     */
+    int setAdaptivePolicy(const SI7050AdaptivePolicy &policy);
+
+    /** Get the adaptive sampling policy */
+    const SI7050AdaptivePolicy &getAdaptivePolicy() const;
+
+    /** Get the current interval in us, the period or longer in adaptive mode */
+    uint32_t getInterval() const;
+
+    /** Get the timing statistics */
+    const SI7050SamplerStats &getStats() const;
+
+private:
+    enum State {
+        STOPPED,
+        WAITING,
+        CONVERTING
+    };
+
+    SI7050Device            &sensor;
+    uint32_t                period;
+    SI7050SampleCallback    callback;
+    void                    *context;
+    State                   state;
+    uint32_t                deadline;
+    uint32_t                interval;
+    uint32_t                startTime;
+    SI7050SamplerStats      stats;
+
+    SI7050AdaptivePolicy    adaptive;
+    uint32_t                bandRaw;
+    uint16_t                anchor;         // raw value of the last change
+    bool                    anchored;
+    int                     stable;         // flat samples since the last doubling
+    int                     fineBits;       // resolution at the period
+
+    void deliver(int status, const char *data);
+    void adapt(uint16_t raw);
+    void setCoarse(bool coarse);
+    uint32_t untilDeadline();
+
+#ifdef __MBED__
+    EventQueue              *queue;
+    Timeout                 timeout;
+
+    void onTimeout();
+    void onEvent();
+#endif
+};
+
+#endif // MBED_SI7050_SAMPLER_H
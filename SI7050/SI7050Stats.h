@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Stats.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Instrumentation of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_STATS_H
+#define MBED_SI7050_STATS_H
+
+#include <stdint.h>
+
+#include "SI7050Bus.h"
+
+// define SI70_STATS to record the statistics of every SI7050 instance,
+// without it the instrumentation is compiled out
+
+// operations
+#define SI70_OP_RESET       0   // reset()
+#define SI70_OP_CONFIG      1   // initialize(), setResolution()
+#define SI70_OP_MEASURE     2   // measurement, from the start to the result
+#define SI70_OP_IDENT       3   // serial, ID and firmware version from the sensor
+#define SI70_OPS            4
+
+#define SI70_STATS_BUCKETS  16  // latency buckets: [0, 2) us, [2, 4) us, ... [2^15, inf) us
+#define SI70_STATS_ERRORS   8   // error categories, one per bit of ERROR_xxx
+
+/** Statistics of one operation */
+struct SI7050OpStats {
+    uint32_t    calls;                          // number of calls
+    uint32_t    failures;                       // number of failed calls
+    uint32_t    bytes;                          // bytes on the wire, including address bytes
+    uint32_t    maxUs;                          // maximum latency in us
+    uint32_t    histogram[SI70_STATS_BUCKETS];  // latency, bucket n counts [2^n, 2^(n+1)) us
+};
+
+/** SI7050Stats struct
+ *
+ *  Statistics of a SI7050 instance, see SI7050::getStats().
+ */
+struct SI7050Stats {
+    SI7050OpStats   op[SI70_OPS];                   // per operation (SI70_OP_xxx)
+    uint32_t        errors[SI70_STATS_ERRORS];      // per category, errors[n] counts (1 << n)
+    uint32_t        crcRetries;                     // measurements repeated on CRC mismatch
+    uint32_t        pollRetries;                    // reads not acknowledged during the conversion
+
+    /** Get the latency bucket of a duration
+     *
+     * @param us    duration in us
+     * @return      bucket index (floor(log2(us)), 0 for 0 us)
+     */
+    static int bucket(uint32_t us) {
+        int n = 0;
+
+        while (us > 1 && n < SI70_STATS_BUCKETS - 1) {
+            us >>= 1;
+            n++;
+        }
+        return n;
+    }
+
+    /** Count an error of a category
+     *
+     * @param error one of ERROR_xxx
+     */
+    void addError(int error) {
+        for (int n = 0; n < SI70_STATS_ERRORS; n++) {
+            if (error & (1 << n)) {
+                errors[n]++;
+            }
+        }
+    }
+};
+
+
+/** SI7050StatsBus class
+ *
+ *  Bus adapter, which counts the bytes on the wire. A not acknowledged
+ *  transfer is counted with the address byte only.
+ */
+class SI7050StatsBus final : public SI7050Bus
+{
+public:
+
+    explicit SI7050StatsBus(SI7050Bus &bus_obj) : bus(bus_obj), bytes(0) {}
+
+    /** Get the number of bytes on the wire */
+    uint32_t getBytes() const { return bytes; }
+
+    virtual int write(int address, const char *data, int length, bool repeated) {
+        int ret = bus.write(address, data, length, repeated);
+        bytes += 1 + (ret ? 0 : length);
+        return ret;
+    }
+
+    virtual int read(int address, char *data, int length, bool repeated) {
+        int ret = bus.read(address, data, length, repeated);
+        bytes += 1 + (ret ? 0 : length);
+        return ret;
+    }
+
+    virtual void waitUs(uint32_t us) { bus.waitUs(us); }
+    virtual uint32_t readUs() { return bus.readUs(); }
+    virtual void lock() { bus.lock(); }
+    virtual void unlock() { bus.unlock(); }
+    virtual int recover() { return bus.recover(); }
+
+private:
+    SI7050Bus   &bus;
+    uint32_t    bytes;
+};
+
+#endif // MBED_SI7050_STATS_H
@@ -0,0 +1,194 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Sync.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Synchronization primitives of the SI7050 temperature sensor library
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_SYNC_H
+#define MBED_SI7050_SYNC_H
+
+#include <atomic>
+#include <stdint.h>
+
+#ifdef __MBED__
+#include "platform/PlatformMutex.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtos.h"
+#endif
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#ifdef __MBED__
+/** Recursive mutex, the rtos Mutex (or nothing without rtos) */
+typedef PlatformMutex SI7050Mutex;
+#else
+/** Recursive mutex of the host */
+class SI7050Mutex
+{
+public:
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+
+private:
+    std::recursive_mutex mutex;
+};
+#endif
+
+
+/** SI7050ScopedLock class
+ *
+ *  Lock an object (mutex or bus) for the lifetime of the lock.
+ */
+template<typename T>
+class SI7050ScopedLock
+{
+public:
+    explicit SI7050ScopedLock(T &obj) : lockable(obj) { lockable.lock(); }
+    ~SI7050ScopedLock() { lockable.unlock(); }
+
+private:
+    T &lockable;
+
+    SI7050ScopedLock(const SI7050ScopedLock &);
+    SI7050ScopedLock &operator=(const SI7050ScopedLock &);
+};
+
+
+/** SI7050LatestSample class
+ *
+ *  Latest raw sample with timestamp, published by one writer and read by
+ *  any number of readers without lock (sequence lock). A reader retries,
+ *  if the writer updated the sample during the read.
+ */
+class SI7050LatestSample
+{
+public:
+    SI7050LatestSample() : sequence(0), timestamp(0), raw(0) {}
+
+    /** Publish a new sample (one writer at a time)
+     *
+     * @param timestamp_    time base of the bus in us
+     * @param raw_          raw 16 bit temperature code
+     */
+    void publish(uint32_t timestamp_, uint16_t raw_) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+
+        sequence.store(seq + 1, std::memory_order_relaxed);    // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        timestamp.store(timestamp_, std::memory_order_relaxed);
+        raw.store(raw_, std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /** Read the latest sample
+     *
+     * @param timestamp_    storage for the timestamp
+     * @param raw_          storage for the raw value
+     * @return              false if no sample was published yet
+     */
+    bool read(uint32_t *timestamp_, uint16_t *raw_) const {
+        uint32_t seq1, seq2;
+
+        do {
+            seq1 = sequence.load(std::memory_order_acquire);
+            *timestamp_ = timestamp.load(std::memory_order_relaxed);
+            *raw_ = raw.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq2 = sequence.load(std::memory_order_relaxed);
+        } while ((seq1 & 1) || seq1 != seq2);
+
+        return seq1 != 0;
+    }
+
+private:
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> timestamp;
+    std::atomic<uint16_t> raw;
+};
+
+
+#if !defined(__MBED__) || defined(MBED_CONF_RTOS_PRESENT)
+/** SI7050Barrier class
+ *
+ *  Reusable barrier: wait() returns, when all parties have called it.
+ *  Needs the rtos on mbed.
+ */
+class SI7050Barrier
+{
+public:
+    explicit SI7050Barrier(int parties_ = 1) :
+#ifdef __MBED__
+            cond(mutex),
+#endif
+            parties(parties_), waiting(0), generation(0) {}
+
+    /** Set the number of parties, only while no party waits */
+    void setParties(int parties_) {
+        parties = parties_;
+        waiting = 0;
+    }
+
+    /** Wait for the other parties */
+    void wait() {
+#ifdef __MBED__
+        mutex.lock();
+#else
+        std::unique_lock<std::mutex> lock(mutex);
+#endif
+        uint32_t current = generation;
+
+        if (++waiting == parties) {
+            waiting = 0;
+            generation++;
+            cond.notify_all();
+        } else {
+            while (generation == current) {
+#ifdef __MBED__
+                cond.wait();
+#else
+                cond.wait(lock);
+#endif
+            }
+        }
+#ifdef __MBED__
+        mutex.unlock();
+#endif
+    }
+
+private:
+#ifdef __MBED__
+    rtos::Mutex                 mutex;
+    rtos::ConditionVariable     cond;
+#else
+    std::mutex                  mutex;
+    std::condition_variable     cond;
+#endif
+    int         parties;
+    int         waiting;
+    uint32_t    generation;
+};
+#endif
+
+#endif // MBED_SI7050_SYNC_H
@@ -0,0 +1,193 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Trace.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Recording of the I2C transactions of the SI7050 driver
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include <string.h>
+
+#include "SI7050Trace.h"
+#include "SI7050Sync.h"
+#include "SI7050Varint.h"
+
+
+SI7050TraceBus::SI7050TraceBus(SI7050Bus &bus_obj, uint8_t *buffer_, size_t size_)
+        :
+        bus(bus_obj),
+        buffer(buffer_),
+        size(size_),
+        length(0),
+        records(0),
+        dropped(0),
+        last(bus_obj.readUs()) {
+    /* nothing to do */
+}
+
+size_t SI7050TraceBus::getLength() const {
+    SI7050ScopedLock<SI7050Bus> lock(bus);
+    return length;
+}
+
+uint32_t SI7050TraceBus::getRecords() const {
+    SI7050ScopedLock<SI7050Bus> lock(bus);
+    return records;
+}
+
+uint32_t SI7050TraceBus::getDropped() const {
+    SI7050ScopedLock<SI7050Bus> lock(bus);
+    return dropped;
+}
+
+void SI7050TraceBus::clear() {
+    SI7050ScopedLock<SI7050Bus> lock(bus);
+    length = 0;
+    records = 0;
+    dropped = 0;
+    last = bus.readUs();
+}
+
+void SI7050TraceBus::record(uint8_t flags, int address, uint32_t start, const char *data, int length_) {
+    SI7050ScopedLock<SI7050Bus> lock(bus);
+    uint32_t end = bus.readUs();
+
+    // a failed read has no data
+    if ((flags & SI70_TRACE_READ) && (flags & SI70_TRACE_NACK)) {
+        data = NULL;
+    }
+    size_t dataLength = data ? (size_t) length_ : 0;
+    if (length + SI70_TRACE_MAX_HEADER + dataLength > size) {
+        dropped++;
+        return;
+    }
+
+    buffer[length++] = flags;
+    buffer[length++] = (uint8_t) address;
+    length += SI7050Varint::write(&buffer[length], start - last);
+    length += SI7050Varint::write(&buffer[length], end - start);
+    length += SI7050Varint::write(&buffer[length], (uint32_t) length_);
+    if (dataLength) {
+        memcpy(&buffer[length], data, dataLength);
+        length += dataLength;
+    }
+    last = start;
+    records++;
+}
+
+int SI7050TraceBus::write(int address, const char *data, int length_, bool repeated) {
+    uint32_t start = bus.readUs();
+    int ret = bus.write(address, data, length_, repeated);
+
+    record((uint8_t) ((repeated ? SI70_TRACE_REPEATED : 0) | (ret ? SI70_TRACE_NACK : 0)),
+           address, start, data, length_);
+    return ret;
+}
+
+int SI7050TraceBus::read(int address, char *data, int length_, bool repeated) {
+    uint32_t start = bus.readUs();
+    int ret = bus.read(address, data, length_, repeated);
+
+    record((uint8_t) (SI70_TRACE_READ | (repeated ? SI70_TRACE_REPEATED : 0) | (ret ? SI70_TRACE_NACK : 0)),
+           address, start, data, length_);
+    return ret;
+}
+
+int SI7050TraceBus::recover() {
+    uint32_t start = bus.readUs();
+    int ret = bus.recover();
+
+    record((uint8_t) (SI70_TRACE_RECOVER | (ret ? SI70_TRACE_NACK : 0)), 0, start, NULL, 0);
+    return ret;
+}
+
+
+SI7050TraceReader::SI7050TraceReader(const uint8_t *trace_, size_t length_, uint32_t start)
+        :
+        trace(trace_),
+        length(length_),
+        position(0),
+        time(start) {
+    /* nothing to do */
+}
+
+bool SI7050TraceReader::readVarint(uint32_t *value) {
+    return SI7050Varint::read(trace, &position, length, value);
+}
+
+int SI7050TraceReader::next(SI7050TraceRecord *record) {
+    uint32_t delta, duration, dataLength;
+
+    if (position >= length) {
+        return 1;
+    }
+    if (length - position < 2) {
+        return -1;
+    }
+
+    size_t start = position;
+    record->flags = trace[position++];
+    record->address = trace[position++];
+    if (!readVarint(&delta) || !readVarint(&duration) || !readVarint(&dataLength) || dataLength > 0xFFFF) {
+        position = start;
+        return -1;
+    }
+
+    record->data = NULL;
+    if (!(record->flags & SI70_TRACE_RECOVER)
+        && (!(record->flags & SI70_TRACE_READ) || !(record->flags & SI70_TRACE_NACK))) {
+        if (length - position < dataLength) {
+            position = start;
+            return -1;
+        }
+        record->data = &trace[position];
+        position += dataLength;
+    }
+
+    time += delta;
+    record->timestamp = time;
+    record->duration = duration;
+    record->length = (uint16_t) dataLength;
+    return 0;
+}
+
+size_t SI7050TraceReader::getPosition() const {
+    return position;
+}
+
+int SI7050TraceReader::compare(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength) {
+    SI7050TraceReader readerA(a, aLength), readerB(b, bLength);
+    SI7050TraceRecord recordA = {}, recordB = {};
+
+    for (int index = 0;; index++) {
+        int retA = readerA.next(&recordA);
+        int retB = readerB.next(&recordB);
+
+        if (retA || retB) {
+            return retA == 1 && retB == 1 ? -1 : index;
+        }
+        if (recordA.flags != recordB.flags || recordA.address != recordB.address
+            || recordA.length != recordB.length || (recordA.data == NULL) != (recordB.data == NULL)
+            || (recordA.data && memcmp(recordA.data, recordB.data, recordA.length))) {
+            return index;
+        }
+    }
+}
@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Trace.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Recording of the I2C transactions of the SI7050 driver
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_TRACE_H
+#define MBED_SI7050_TRACE_H
+
+#include "SI7050Bus.h"
+
+/*
+ * Trace format, one record per transaction:
+ *
+ *   flags      1 Byte, SI70_TRACE_xxx
+ *   address    1 Byte, 8 bit I2C address
+ *   time       varint, start of the transaction in us since the last record
+ *              (the first record since the start of the trace)
+ *   duration   varint, duration of the transaction in us
+ *   length     varint, number of data Bytes of the transaction
+ *   data       the written data, or the read data if the read was ACKed
+ *
+ * A varint is stored in 7 bit groups, lowest first, the high bit of a Byte
+ * marks that another one follows.
+ */
+#define SI70_TRACE_READ         0x01    // read, otherwise write
+#define SI70_TRACE_REPEATED     0x02    // repeated start, no stop at the end
+#define SI70_TRACE_NACK         0x04    // the transaction failed
+#define SI70_TRACE_RECOVER      0x08    // bus recovery, no address and data
+#define SI70_TRACE_MAX_HEADER   17      // flags, address and 3 varints
+
+/** Transaction of a trace, the data points into the trace */
+struct SI7050TraceRecord {
+    uint32_t        timestamp;  // start of the transaction in us
+    uint32_t        duration;   // duration of the transaction in us
+    uint8_t         flags;      // SI70_TRACE_xxx
+    uint8_t         address;    // 8 bit I2C address
+    uint16_t        length;     // number of data Bytes of the transaction
+    const uint8_t   *data;      // data, NULL if the read failed
+};
+
+/** SI7050TraceBus class
+ *
+ *  Bus wrapper, which records every transaction into a buffer of the
+ *  caller and forwards it to the real bus. If the buffer is full, the
+ *  further transactions are only counted. The trace can be read with
+ *  SI7050TraceReader, sent to a host and replayed there with
+ *  SimReplayBus.
+ *
+ *  Several sensors and threads can use the bus: a record is appended
+ *  with the bus locked (the lock of the bus is recursive), read the trace
+ *  with the bus locked, too.
+ *
+ * @code
+ * static uint8_t trace[2048];
+ * SI7050I2CBus i2cBus(i2c);
+ * SI7050TraceBus bus(i2cBus, trace, sizeof(trace));
+ * SI7050 sensor(bus);
+ *
+ * sensor.initialize();
+ * sensor.getTemperature();
+ * send(trace, bus.getLength());
+ * @endcode
+ */
+class SI7050TraceBus final : public SI7050Bus
+{
+public:
+
+    /** Create a recording bus
+     *
+     * @param bus_obj   bus, which does the transactions (instance)
+     * @param buffer    storage for the trace
+     * @param size      size of the storage
+     */
+    SI7050TraceBus(SI7050Bus &bus_obj, uint8_t *buffer, size_t size);
+
+    /** Get the length of the trace in Bytes */
+    size_t getLength() const;
+
+    /** Get the number of recorded transactions */
+    uint32_t getRecords() const;
+
+    /** Get the number of transactions, which did not fit into the buffer */
+    uint32_t getDropped() const;
+
+    /** Start a new trace, the next record is relative to the current time */
+    void clear();
+
+    virtual int write(int address, const char *data, int length, bool repeated);
+    virtual int read(int address, char *data, int length, bool repeated);
+    virtual void waitUs(uint32_t us) { bus.waitUs(us); }
+    virtual uint32_t readUs() { return bus.readUs(); }
+    virtual void lock() { bus.lock(); }
+    virtual void unlock() { bus.unlock(); }
+    virtual int recover();
+
+private:
+    SI7050Bus   &bus;
+    uint8_t     *buffer;
+    size_t      size;
+    size_t      length;
+    uint32_t    records;
+    uint32_t    dropped;
+    uint32_t    last;       // start of the last record
+
+    void record(uint8_t flags, int address, uint32_t start, const char *data, int length);
+};
+
+/** SI7050TraceReader class
+ *
+ *  Read the records of a trace in place.
+ */
+class SI7050TraceReader
+{
+public:
+
+    /** Create a reader
+     *
+     * @param trace     trace data
+     * @param length    length of the trace in Bytes
+     * @param start     (option) time of the start of the trace
+     */
+    SI7050TraceReader(const uint8_t *trace, size_t length, uint32_t start = 0);
+
+    /** Read the next record
+     *
+     * @param record    storage for the record
+     * @return          (0) on success, (1) at the end of the trace,
+     *                  (-1) if the trace is broken
+     */
+    int next(SI7050TraceRecord *record);
+
+    /** Get the offset of the next record in the trace */
+    size_t getPosition() const;
+
+    /** Compare the transactions of two traces, without the timing
+     *
+     * @param a         first trace
+     * @param aLength   length of the first trace
+     * @param b         second trace
+     * @param bLength   length of the second trace
+     * @return          index of the first differing transaction,
+     *                  (-1) if the traces are equal
+     */
+    static int compare(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength);
+
+private:
+    const uint8_t   *trace;
+    size_t          length;
+    size_t          position;
+    uint32_t        time;
+
+    bool readVarint(uint32_t *value);
+};
+
+#endif // MBED_SI7050_TRACE_H
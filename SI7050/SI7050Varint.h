@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Varint.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Varint coding of the SI7050 log and trace formats
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_VARINT_H
+#define MBED_SI7050_VARINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SI70_VARINT_MAX_SIZE    5       // Bytes of a 32 bit varint
+
+/** SI7050Varint struct
+ *
+ *  A varint is stored in 7 bit groups, lowest first, the high bit of a
+ *  Byte marks that another one follows. Internal to SI7050Log and
+ *  SI7050Trace.
+ */
+struct SI7050Varint
+{
+    /** Write a varint
+     *
+     * @param out       storage for up to SI70_VARINT_MAX_SIZE Bytes
+     * @param value     value to write
+     * @return          number of written Bytes
+     */
+    static inline size_t write(uint8_t *out, uint32_t value) {
+        size_t n = 0;
+
+        while (value >= 0x80) {
+            out[n++] = (uint8_t) (value | 0x80);
+            value >>= 7;
+        }
+        out[n++] = (uint8_t) value;
+        return n;
+    }
+
+    /** Read a varint
+     *
+     * @param data      data, which contains the varint
+     * @param position  position of the varint, advanced behind it
+     * @param end       end of the data, which may be read
+     * @param value     the read value
+     * @return          false if the varint is not complete before end or
+     *                  longer than SI70_VARINT_MAX_SIZE Bytes
+     */
+    static inline bool read(const uint8_t *data, size_t *position, size_t end, uint32_t *value) {
+        uint32_t result = 0;
+
+        for (int bits = 0; bits < 7 * SI70_VARINT_MAX_SIZE && *position < end; bits += 7) {
+            uint8_t byte = data[(*position)++];
+            result |= (uint32_t) (byte & 0x7F) << bits;
+            if (!(byte & 0x80)) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // MBED_SI7050_VARINT_H
@@ -0,0 +1,103 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Window.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Streaming window aggregates of raw SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SI7050Window.h"
+#include "Si705x.h"
+
+// integer square root, rounded down
+static uint32_t isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t) 1 << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t) root;
+}
+
+bool SI7050Moments::summarize(uint16_t minRaw, uint16_t maxRaw, SI7050Summary *summary) const {
+    if (count == 0) {
+        return false;
+    }
+
+    // T = ((17572 * raw) >> 16) - 4685, for the mean with the fraction of sum / count
+    summary->count = count;
+    summary->min = Si705xCentiCelsius::fromRaw(minRaw);
+    summary->max = Si705xCentiCelsius::fromRaw(maxRaw);
+    summary->mean = (int16_t) ((int64_t) ((17572 * sum) / ((uint64_t) count << 16)) - 4685);
+
+    // count^2 * variance = count * squares - sum^2, exact; the standard
+    // deviation of the raw codes is sqrt(that) / count
+    uint64_t spread = count * squares - sum * sum;
+    summary->stddev = (uint16_t) (((uint64_t) isqrt(spread) * 17572 + ((uint64_t) count << 15))
+                                  / ((uint64_t) count << 16));
+    return true;
+}
+
+
+SI7050TumblingWindow::SI7050TumblingWindow(uint32_t length_)
+        :
+        length(length_ < 1 ? 1 : length_ > SI70_WINDOW_MAX_LENGTH ? SI70_WINDOW_MAX_LENGTH : length_),
+        minRaw(0xFFFF),
+        maxRaw(0) {
+    /* nothing to do */
+}
+
+bool SI7050TumblingWindow::update(uint16_t raw, SI7050Summary *summary) {
+    moments.add(raw);
+    if (raw < minRaw) {
+        minRaw = raw;
+    }
+    if (raw > maxRaw) {
+        maxRaw = raw;
+    }
+
+    if (moments.getCount() < length) {
+        return false;
+    }
+    moments.summarize(minRaw, maxRaw, summary);
+    reset();
+    return true;
+}
+
+bool SI7050TumblingWindow::peek(SI7050Summary *summary) const {
+    return moments.summarize(minRaw, maxRaw, summary);
+}
+
+void SI7050TumblingWindow::reset() {
+    moments.reset();
+    minRaw = 0xFFFF;
+    maxRaw = 0;
+}
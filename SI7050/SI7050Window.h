@@ -0,0 +1,278 @@
+/**
+ ******************************************************************************
+ * @file    SI7050Window.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Streaming window aggregates of raw SI7050 samples
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef MBED_SI7050_WINDOW_H
+#define MBED_SI7050_WINDOW_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SI70_WINDOW_MAX_LENGTH  65535
+
+/** Summary of a window, in 0.01°C */
+struct SI7050Summary {
+    uint32_t    count;      // number of samples in the window
+    int16_t     min;
+    int16_t     max;
+    int16_t     mean;
+    uint16_t    stddev;     // population standard deviation
+};
+
+/** SI7050Moments class
+ *
+ *  Count, sum and sum of squares of raw samples. The raw codes are 16 bit
+ *  integers, so the sums are exact in 64 bit and samples can also be
+ *  removed (sliding windows) without the rounding drift of an
+ *  incremental mean/variance update.
+ */
+class SI7050Moments
+{
+public:
+    SI7050Moments() : count(0), sum(0), squares(0) {}
+
+    void add(uint16_t raw) {
+        count++;
+        sum += raw;
+        squares += (uint64_t) raw * raw;
+    }
+
+    void remove(uint16_t raw) {
+        count--;
+        sum -= raw;
+        squares -= (uint64_t) raw * raw;
+    }
+
+    void reset() {
+        count = 0;
+        sum = 0;
+        squares = 0;
+    }
+
+    /** Get the number of samples */
+    uint32_t getCount() const {
+        return count;
+    }
+
+    /** Convert to a summary, only here the temperature is calculated
+     *
+     * @param minRaw    smallest raw code of the window
+     * @param maxRaw    largest raw code of the window
+     * @param summary   storage for the summary
+     * @return          false if the window is empty
+     */
+    bool summarize(uint16_t minRaw, uint16_t maxRaw, SI7050Summary *summary) const;
+
+private:
+    uint32_t    count;
+    uint64_t    sum;
+    uint64_t    squares;
+};
+
+
+/** SI7050TumblingWindow class
+ *
+ *  Aggregate blocks of a fixed number of samples, e.g. 60 samples of a
+ *  1 s period for a summary per minute. O(1) per sample, no buffer. Use
+ *  one object per window length to get several lengths at once.
+ *
+ * @code
+ * SI7050TumblingWindow minute(60), hour(3600);
+ * SI7050Summary summary;
+ *
+ * uint16_t raw = sample.raw & sensor.getRawMask();
+ * if (minute.update(raw, &summary)) {
+ *     send(summary);
+ * }
+ * if (hour.update(raw, &summary)) {
+ *     store(summary);
+ * }
+ * @endcode
+ */
+class SI7050TumblingWindow
+{
+public:
+
+    /** Create a window
+     *
+     * @param length    number of samples per window (1 to 65535, the exact
+     *                  sums of longer windows would overflow)
+     */
+    explicit SI7050TumblingWindow(uint32_t length);
+
+    /** Add a sample
+     *
+     * @param raw       raw 16 bit temperature code
+     * @param summary   storage for the summary of the window
+     * @return          true if the window is complete, the summary is
+     *                  written and the next window starts
+     */
+    bool update(uint16_t raw, SI7050Summary *summary);
+
+    /** Get the summary of the samples of the current, incomplete window
+     *
+     * @return          false if the window is empty
+     */
+    bool peek(SI7050Summary *summary) const;
+
+    /** Discard the current window */
+    void reset();
+
+private:
+    uint32_t        length;
+    SI7050Moments   moments;
+    uint16_t        minRaw;
+    uint16_t        maxRaw;
+};
+
+
+/** SI7050SlidingWindow class
+ *
+ *  Aggregate of the last N samples. Minimum and maximum are kept in
+ *  monotonic queues (each sample is pushed and popped at most once, O(1)
+ *  amortized), mean and standard deviation in exact sums. No heap.
+ *
+ * @tparam  N   window length in samples
+ *
+ * @code
+ * SI7050SlidingWindow<10> recent;
+ *
+ * recent.update(sample.raw & sensor.getRawMask());
+ * SI7050Summary summary;
+ * recent.get(&summary);
+ * @endcode
+ */
+template<unsigned N>
+class SI7050SlidingWindow
+{
+    static_assert(N >= 1 && N <= SI70_WINDOW_MAX_LENGTH, "window length must be 1..65535");
+
+public:
+
+    SI7050SlidingWindow() : position(0), sequence(0) {}
+
+    /** Add a sample, the oldest one leaves a full window
+     *
+     * @param raw       raw 16 bit temperature code
+     */
+    void update(uint16_t raw) {
+        if (moments.getCount() == N) {
+            moments.remove(values[position]);
+        }
+        values[position] = raw;
+        position = position + 1 == N ? 0 : position + 1;
+        moments.add(raw);
+
+        // the entries, which left the window, are at the front
+        uint32_t oldest = sequence - (N - 1);
+        minimum.expire(oldest);
+        maximum.expire(oldest);
+        minimum.push(sequence, raw);
+        maximum.push(sequence, (uint16_t) ~raw);
+        sequence++;
+    }
+
+    /** Get the summary of the window
+     *
+     * @return          false if no sample was added
+     */
+    bool get(SI7050Summary *summary) const {
+        if (moments.getCount() == 0) {
+            return false;
+        }
+        return moments.summarize(minimum.front(), (uint16_t) ~maximum.front(), summary);
+    }
+
+    /** Get the number of samples in the window (up to N) */
+    uint32_t size() const {
+        return moments.getCount();
+    }
+
+    void reset() {
+        moments.reset();
+        minimum.reset();
+        maximum.reset();
+        position = 0;
+    }
+
+private:
+    // queue of candidates for the minimum, increasing from front to back;
+    // the maximum is the minimum of the inverted codes
+    class MonotonicQueue
+    {
+    public:
+        MonotonicQueue() : head(0), length(0) {}
+
+        void push(uint32_t sequence, uint16_t value) {
+            // candidates, which are not smaller than the new value, never win again
+            while (length > 0 && entries[back()].value >= value) {
+                length--;
+            }
+            unsigned slot = head + length < N ? head + length : head + length - N;
+            entries[slot].sequence = sequence;
+            entries[slot].value = value;
+            length++;
+        }
+
+        void expire(uint32_t oldest) {
+            while (length > 0 && (int32_t) (entries[head].sequence - oldest) < 0) {
+                head = head + 1 == N ? 0 : head + 1;
+                length--;
+            }
+        }
+
+        uint16_t front() const {
+            return entries[head].value;
+        }
+
+        void reset() {
+            head = 0;
+            length = 0;
+        }
+
+    private:
+        struct Entry {
+            uint32_t    sequence;
+            uint16_t    value;
+        };
+
+        Entry       entries[N];
+        unsigned    head;
+        unsigned    length;
+
+        unsigned back() const {
+            return head + length - 1 < N ? head + length - 1 : head + length - 1 - N;
+        }
+    };
+
+    uint16_t        values[N];
+    unsigned        position;
+    uint32_t        sequence;
+    SI7050Moments   moments;
+    MonotonicQueue  minimum;
+    MonotonicQueue  maximum;
+};
+
+#endif // MBED_SI7050_WINDOW_H
@@ -0,0 +1,473 @@
+/**
+ ******************************************************************************
+ * @file    Si705x.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Compile-time specialized driver template of the Si705x temperature sensors
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+/**
+ *  For more information about the SI7050:
+ *    https://www.silabs.com/documents/public/data-sheets/Si7050-1-3-4-5-A20.pdf
+ */
+
+#ifndef MBED_SI705X_H
+#define MBED_SI705X_H
+
+#include "SI7050Bus.h"
+#include "SI7050Convert.h"
+#include "SI7050Crc.h"
+#include "SI7050Sync.h"
+
+// sensor commands
+#define SI70_ADDRESS    (0x40 << 1)
+#define SI70_MEASURE    0xF3    // WG was E3 before// measure temperature, hold master mode
+#define SI70_MEASURE_HOLD 0xE3  // measure temperature, hold master mode (clock stretching)
+#define SI70_RESET      0xFE    // reset
+#define SI70_WRITE_UR   0xE6    // write user register 1
+#define SI70_READ_UR    0xE7    // read user register 1
+#define SI70_READ_FW_1  0x84    // read the firmware version (first command)
+#define SI70_READ_FW_2  0xB8    // read the firmware version (second command)
+#define SI70_READ_ID_11 0xFA    // read the electronic ID (first Byte, first command)
+#define SI70_READ_ID_12 0x0F    // read the electronic ID (first Byte, second command)
+#define SI70_READ_ID_21 0xFC    // read the electronic ID (second Byte, first command)
+#define SI70_READ_ID_22 0xC9    // read the electronic ID (second Byte, second command)
+
+
+// resolution settings (user register 1)
+#define SI70_RES_MASK   0x81
+#define SI70_RES_14BIT  0x00
+#define SI70_RES_13BIT  0x80
+#define SI70_RES_12BIT  0x01
+#define SI70_RES_11BIT  0x81
+
+// measurement timing (maximum conversion time from the datasheet)
+#define SI70_CONV_TIME_14BIT_US 10800
+#define SI70_CONV_TIME_13BIT_US 6200
+#define SI70_CONV_TIME_12BIT_US 3800
+#define SI70_CONV_TIME_11BIT_US 2400
+#define SI70_RESET_TIME_US      15000   // the sensor does not answer after a reset
+
+/** Si705xResolution struct
+ *
+ *  Compile-time constants of a resolution.
+ *
+ * @tparam  BITS    resolution in bits (11, 12, 13 or 14)
+ */
+template<int BITS>
+struct Si705xResolution;
+
+template<>
+struct Si705xResolution<14> {
+    static constexpr int bits = 14;
+    static constexpr char userRegister = SI70_RES_14BIT;
+    static constexpr uint16_t mask = SI70_MASK_14BIT;
+    static constexpr uint32_t conversionUs = SI70_CONV_TIME_14BIT_US;
+};
+
+template<>
+struct Si705xResolution<13> {
+    static constexpr int bits = 13;
+    static constexpr char userRegister = (char) SI70_RES_13BIT;
+    static constexpr uint16_t mask = SI70_MASK_13BIT;
+    static constexpr uint32_t conversionUs = SI70_CONV_TIME_13BIT_US;
+};
+
+template<>
+struct Si705xResolution<12> {
+    static constexpr int bits = 12;
+    static constexpr char userRegister = SI70_RES_12BIT;
+    static constexpr uint16_t mask = SI70_MASK_12BIT;
+    static constexpr uint32_t conversionUs = SI70_CONV_TIME_12BIT_US;
+};
+
+template<>
+struct Si705xResolution<11> {
+    static constexpr int bits = 11;
+    static constexpr char userRegister = (char) SI70_RES_11BIT;
+    static constexpr uint16_t mask = SI70_MASK_11BIT;
+    static constexpr uint32_t conversionUs = SI70_CONV_TIME_11BIT_US;
+};
+
+
+/** Si705xResolutions struct
+ *
+ *  Lookup of the Si705xResolution constants for a resolution, which is
+ *  selected at runtime. An unsupported resolution maps to 14 bit.
+ */
+struct Si705xResolutions {
+    int         bits;
+    char        userRegister;
+    uint16_t    mask;
+    uint32_t    conversionUs;
+
+    /** Constants of a resolution in bits (11, 12, 13 or 14) */
+    static constexpr Si705xResolutions fromBits(int bits) {
+        return bits == 11 ? of<11>() : bits == 12 ? of<12>() : bits == 13 ? of<13>() : of<14>();
+    }
+
+    /** Constants of the resolution bits of user register 1 */
+    static constexpr Si705xResolutions fromUserRegister(char value) {
+        return (value & SI70_RES_MASK) == (of<11>().userRegister & SI70_RES_MASK) ? of<11>() :
+               (value & SI70_RES_MASK) == (of<12>().userRegister & SI70_RES_MASK) ? of<12>() :
+               (value & SI70_RES_MASK) == (of<13>().userRegister & SI70_RES_MASK) ? of<13>() : of<14>();
+    }
+
+    /** true if the resolution in bits is supported */
+    static constexpr bool supported(int bits) {
+        return bits >= 11 && bits <= 14;
+    }
+
+private:
+    template<int BITS>
+    static constexpr Si705xResolutions of() {
+        return {Si705xResolution<BITS>::bits, Si705xResolution<BITS>::userRegister,
+                Si705xResolution<BITS>::mask, Si705xResolution<BITS>::conversionUs};
+    }
+};
+
+static_assert(Si705xResolutions::fromBits(13).conversionUs == SI70_CONV_TIME_13BIT_US, "resolution lookup");
+static_assert(Si705xResolutions::fromUserRegister((char) SI70_RES_11BIT).bits == 11, "resolution lookup");
+
+
+/** Output unit: temperature in 0.01°C */
+struct Si705xCentiCelsius {
+    typedef int16_t type;
+    static constexpr type error = -32768;
+
+    static constexpr type fromRaw(uint16_t raw) {
+        return (type) (((17572u * raw) >> 16) - 4685);
+    }
+};
+
+/** Output unit: temperature in 0.001°C */
+struct Si705xMilliCelsius {
+    typedef int32_t type;
+    static constexpr type error = INT32_MIN;
+
+    static constexpr type fromRaw(uint16_t raw) {
+        return (type) (((175720ull * raw) >> 16)) - 46850;
+    }
+};
+
+
+/** Si705xSerial struct
+ *
+ *  Layout of the electronic ID, as read by the two ID commands.
+ */
+struct Si705xSerial {
+
+    /** Extract the 8 ID Bytes from the raw data
+     *
+     * @param  data     raw data of the two accesses (16 Bytes)
+     * @param  serial   storage for the serial number (8 Bytes)
+     */
+    static void decode(const char data[16], unsigned char serial[8]) {
+        serial[0] = (unsigned char) data[0];
+        serial[1] = (unsigned char) data[2];
+        serial[2] = (unsigned char) data[4];
+        serial[3] = (unsigned char) data[6];
+        serial[4] = (unsigned char) data[8];
+        serial[5] = (unsigned char) data[9];
+        serial[6] = (unsigned char) data[11];
+        serial[7] = (unsigned char) data[12];
+    }
+
+    /** Check the CRC Bytes of the raw data
+     *
+     * @param  data     raw data of the two accesses (16 Bytes)
+     * @return          true if all CRC Bytes match
+     */
+    static bool check(const unsigned char *data) {
+        unsigned char crc;
+
+        // SNA_3, CRC, SNA_2, CRC, SNA_1, CRC, SNA_0, CRC, the CRC runs over the ID Bytes
+        crc = 0;
+        for (int i = 0; i < 8; i += 2) {
+            crc = SI7050Crc::calc(&data[i], 1, crc);
+            if (data[i + 1] != crc)
+                return false;
+        }
+
+        // SNB_3, SNB_2, CRC, SNB_1, SNB_0, CRC
+        crc = 0;
+        for (int i = 8; i < 14; i += 3) {
+            crc = SI7050Crc::calc(&data[i], 2, crc);
+            if (data[i + 2] != crc)
+                return false;
+        }
+
+        return true;
+    }
+};
+
+
+/** Si705xTable struct
+ *
+ *  Lookup table of the temperature for every raw value of a resolution,
+ *  generated at compile time. It has 2^BITS entries, so it is intended
+ *  for the lower resolutions (e.g. 4 kB for 11 bit in 0.01°C).
+ */
+template<int BITS, typename Unit>
+struct Si705xTable
+{
+    typename Unit::type value[1 << BITS];
+
+    constexpr Si705xTable() : value() {
+        for (int i = 0; i < (1 << BITS); i++) {
+            value[i] = Unit::fromRaw((uint16_t) (i << (16 - BITS)));
+        }
+    }
+};
+
+
+/** Si705x class
+ *
+ *  Header-only driver of the Si705x sensors, with the bus type, the
+ *  resolution and the output unit fixed at compile time. All constants
+ *  (user register bits, data mask, conversion time) are constexpr and
+ *  the driver has no virtual functions and no state besides the bus and
+ *  the address, so flash and cycle count are predictable.
+ *
+ *  The bus type needs the functions of SI7050Bus (write(), read(),
+ *  waitUs(), lock() and unlock()), but they do not have to be virtual.
+ *  Transfers, which belong together, are done with the bus locked.
+ *  The SI7050 class uses the transfer functions of this template.
+ *
+ * @tparam  Bus     bus type, e.g. SI7050I2CBus
+ * @tparam  BITS    resolution in bits (11, 12, 13 or 14)
+ * @tparam  Unit    output unit, Si705xCentiCelsius or Si705xMilliCelsius
+ *
+ * @code
+ * I2C i2c(I2C_SDA, I2C_SCL);
+ * SI7050I2CBus bus(i2c);
+ * Si705x<SI7050I2CBus, 11> sensor(bus);
+ *
+ * sensor.initialize();
+ * int16_t temp = sensor.getTemperature();
+ * @endcode
+ */
+template<typename Bus, int BITS = 14, typename Unit = Si705xCentiCelsius>
+class Si705x
+{
+public:
+    typedef Si705xResolution<BITS> Resolution;
+    typedef typename Unit::type Temperature;
+
+    static constexpr uint16_t mask = Resolution::mask;
+    static constexpr uint32_t conversionUs = Resolution::conversionUs;
+
+    /** Create a Si705x instance
+     *
+     * @param bus_obj bus object (instance)
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    explicit Si705x(Bus &bus_obj, char slave_adr = (char) SI70_ADDRESS) : bus(bus_obj), address(slave_adr) {}
+
+    /** Reset the sensor (wait 15 ms before the next access)
+     *
+     *  @return         (0) if no error, none (0) if error
+     */
+    int reset() {
+        const char cmd = (char) SI70_RESET;
+        return bus.write(address, &cmd, 1, false);
+    }
+
+    /** Write the resolution into the user register
+     *
+     *  @return         (0) if no error, none (0) if error
+     */
+    int initialize() {
+        char value;
+        SI7050ScopedLock<Bus> lock(bus);
+
+        if (readUserRegister(&value)) {
+            return -1;
+        }
+        return writeUserRegister((char) ((value & ~SI70_RES_MASK) | Resolution::userRegister));
+    }
+
+    /** Read the user register
+     *
+     *  @param  value   storage for the register value
+     *  @return         (0) if no error, (-1) if the command failed,
+     *                  (1) if the read failed
+     */
+    int readUserRegister(char *value) {
+        const char cmd = (char) SI70_READ_UR;
+        SI7050ScopedLock<Bus> lock(bus);
+
+        if (bus.write(address, &cmd, 1, true)) {
+            return -1;
+        }
+        return bus.read(address, value, 1, false) ? 1 : 0;
+    }
+
+    /** Write the user register
+     *
+     *  @param  value   register value
+     *  @return         (0) if no error, none (0) if error
+     */
+    int writeUserRegister(char value) {
+        const char cmd[2] = {(char) SI70_WRITE_UR, value};
+        return bus.write(address, cmd, 2, false);
+    }
+
+    /** Start a measurement in no hold master mode
+     *
+     *  @return         (0) if no error, none (0) if error
+     */
+    int startMeasurement() {
+        const char cmd = (char) SI70_MEASURE;
+        return bus.write(address, &cmd, 1, false);
+    }
+
+    /** Read the result of a measurement, the sensor does not acknowledge
+     *  until the conversion is done
+     *
+     *  @param  data    storage for MSB, LSB and optional CRC
+     *  @param  length  2, or 3 to read the CRC
+     *  @return         (0) if no error, none (0) if error or not ready
+     */
+    int readMeasurement(char *data, int length) {
+        return bus.read(address, data, length, false);
+    }
+
+    /** Measure in hold master mode, the sensor stretches the clock
+     *  until the conversion is done
+     *
+     *  @param  data    storage for MSB, LSB and optional CRC
+     *  @param  length  2, or 3 to read the CRC
+     *  @return         (0) if no error, none (0) if error
+     */
+    int measureHold(char *data, int length) {
+        const char cmd = (char) SI70_MEASURE_HOLD;
+        SI7050ScopedLock<Bus> lock(bus);
+
+        if (bus.write(address, &cmd, 1, true)) {
+            return -1;
+        }
+        return bus.read(address, data, length, false);
+    }
+
+    /** Measure and read the raw temperature
+     *
+     *  @param  raw     storage for the raw value (masked to the resolution)
+     *  @return         (0) if no error, none (0) if error
+     */
+    int measure(uint16_t *raw) {
+        char data[2];
+
+        if (startMeasurement()) {
+            return -1;
+        }
+        bus.waitUs(conversionUs);
+        if (readMeasurement(data, 2)) {
+            return -1;
+        }
+        *raw = (uint16_t) ((((unsigned char) data[0] << 8) | (unsigned char) data[1]) & mask);
+        return 0;
+    }
+
+    /** Measure the temperature
+     *
+     *  @return         temperature in the output unit, or Unit::error
+     */
+    Temperature getTemperature() {
+        uint16_t raw;
+
+        if (measure(&raw)) {
+            return Unit::error;
+        }
+        return convert(raw);
+    }
+
+    /** Read the firmware version
+     *
+     *  @return         0xFF = version 1.0, 0x20 = version 2.0, (-1) if error
+     */
+    int readFirmwareVersion() {
+        const char cmd[2] = {(char) SI70_READ_FW_1, (char) SI70_READ_FW_2};
+        char data;
+        SI7050ScopedLock<Bus> lock(bus);
+
+        if (bus.write(address, cmd, 2, false) || bus.read(address, &data, 1, false)) {
+            return -1;
+        }
+        return (unsigned char) data;
+    }
+
+    /** Read the electronic ID with the CRC Bytes
+     *
+     *  @param  data    storage for the two accesses of 8 Bytes each
+     *  @return         (0) if no error, none (0) if error
+     */
+    int readSerialRaw(char data[16]) {
+        const char cmd1[2] = {(char) SI70_READ_ID_11, (char) SI70_READ_ID_12};
+        const char cmd2[2] = {(char) SI70_READ_ID_21, (char) SI70_READ_ID_22};
+        SI7050ScopedLock<Bus> lock(bus);
+
+        if (bus.write(address, cmd1, 2, true) || bus.read(address, data, 8, false)) {
+            return -1;
+        }
+        if (bus.write(address, cmd2, 2, true) || bus.read(address, &data[8], 8, false)) {
+            return -1;
+        }
+        return 0;
+    }
+
+    /** Convert a raw value into the output unit
+     *
+     *  @param  raw     raw 16 bit temperature code
+     *  @return         temperature in the output unit
+     */
+    static constexpr Temperature convert(uint16_t raw) {
+        return Unit::fromRaw((uint16_t) (raw & mask));
+    }
+
+    /** Convert a raw value with the lookup table of the resolution
+     *
+     *  the table is only linked in, if this function is used
+     *
+     *  @param  raw     raw 16 bit temperature code
+     *  @return         temperature in the output unit
+     */
+    static Temperature lookup(uint16_t raw) {
+        return table.value[raw >> (16 - BITS)];
+    }
+
+private:
+    static constexpr Si705xTable<BITS, Unit> table = Si705xTable<BITS, Unit>();
+
+    Bus     &bus;
+    char    address;
+};
+
+template<typename Bus, int BITS, typename Unit>
+constexpr Si705xTable<BITS, Unit> Si705x<Bus, BITS, Unit>::table;
+
+template<typename Bus, int BITS, typename Unit>
+constexpr uint16_t Si705x<Bus, BITS, Unit>::mask;
+
+template<typename Bus, int BITS, typename Unit>
+constexpr uint32_t Si705x<Bus, BITS, Unit>::conversionUs;
+
+#endif // MBED_SI705X_H
@@ -0,0 +1,146 @@
+/**
+ ******************************************************************************
+ * @file    SimAsyncBus.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Simulated asynchronous I2C bus implementation
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SimAsyncBus.h"
+
+SimAsyncBus::SimAsyncBus(SimI2CBus &bus_obj)
+        :
+        bus(bus_obj),
+        transferEvent(),
+        timerEvent(),
+        address(0),
+        tx(NULL),
+        txLength(0),
+        rx(NULL),
+        rxLength(0),
+        callbacks(0) {
+    /* nothing to do */
+}
+
+int SimAsyncBus::transfer(int address_, const char *tx_, int txLength_, char *rx_, int rxLength_,
+                          SI7050BusCallback callback, void *context) {
+    // like the mbed driver, only one transfer at a time
+    if (transferEvent.pending) {
+        return -1;
+    }
+
+    address = address_;
+    tx = tx_;
+    txLength = txLength_;
+    rx = rx_;
+    rxLength = rxLength_;
+    transferEvent.pending = true;
+    transferEvent.at = bus.readUs();
+    transferEvent.callback = callback;
+    transferEvent.context = context;
+    return 0;
+}
+
+int SimAsyncBus::schedule(uint32_t us, SI7050BusCallback callback, void *context) {
+    // a new timer replaces the pending one
+    timerEvent.pending = true;
+    timerEvent.at = bus.readUs() + us;
+    timerEvent.callback = callback;
+    timerEvent.context = context;
+    return 0;
+}
+
+uint32_t SimAsyncBus::readUs() {
+    return bus.readUs();
+}
+
+SimAsyncBus::Event *SimAsyncBus::next() {
+    if (transferEvent.pending && timerEvent.pending) {
+        return ((int32_t) (timerEvent.at - transferEvent.at) < 0) ? &timerEvent : &transferEvent;
+    }
+    if (transferEvent.pending) {
+        return &transferEvent;
+    }
+    if (timerEvent.pending) {
+        return &timerEvent;
+    }
+    return NULL;
+}
+
+void SimAsyncBus::dispatch(Event &event) {
+    int status = SI70_BUS_DONE;
+
+    event.pending = false;
+    if (&event == &transferEvent) {
+        // the transfer runs on the simulated bus, which advances the clock
+        if (txLength > 0 && bus.write(address, tx, txLength, rxLength > 0)) {
+            status = SI70_BUS_NACK;
+        } else if (rxLength > 0 && bus.read(address, rx, rxLength, false)) {
+            status = SI70_BUS_NACK;
+        }
+    }
+
+    callbacks++;
+    event.callback(event.context, status);
+}
+
+int SimAsyncBus::poll() {
+    int count = 0;
+    Event *event;
+
+    while ((event = next()) != NULL && (int32_t) (event->at - bus.readUs()) <= 0) {
+        dispatch(*event);
+        count++;
+    }
+    return count;
+}
+
+bool SimAsyncBus::runNext() {
+    Event *event = next();
+
+    if (event == NULL) {
+        return false;
+    }
+
+    int32_t remaining = (int32_t) (event->at - bus.readUs());
+    if (remaining > 0) {
+        bus.waitUs((uint32_t) remaining);
+    }
+    dispatch(*event);
+    return true;
+}
+
+int SimAsyncBus::run() {
+    int count = 0;
+
+    while (runNext()) {
+        count++;
+    }
+    return count;
+}
+
+bool SimAsyncBus::isPending() const {
+    return transferEvent.pending || timerEvent.pending;
+}
+
+uint32_t SimAsyncBus::getCallbacks() const {
+    return callbacks;
+}
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    SimAsyncBus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Simulated asynchronous I2C bus
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef SIM_ASYNC_BUS_H
+#define SIM_ASYNC_BUS_H
+
+#include "SimI2CBus.h"
+#include "SI7050AsyncBus.h"
+
+/** SimAsyncBus class
+ *
+ *  SI7050AsyncBus implementation on top of a simulated bus. Transfers and
+ *  timers are queued and only executed by the event loop (poll() or
+ *  run()), which stands in for the interrupts of the real bus. Between
+ *  the start of an operation and the event loop, the application can do
+ *  other work.
+ *
+ * @code
+ * SimI2CBus bus;
+ * SimAsyncBus async(bus);
+ * SI7050Async sensor(async);
+ *
+ * sensor.measureTemperature(callback);
+ * async.run();
+ * @endcode
+ */
+class SimAsyncBus : public SI7050AsyncBus
+{
+public:
+
+    /** Create an asynchronous bus on a simulated bus
+     *
+     * @param bus_obj   simulated bus (instance)
+     */
+    explicit SimAsyncBus(SimI2CBus &bus_obj);
+
+    /** Dispatch the events, which are due, without advancing the clock
+     *
+     * @return          number of dispatched events
+     */
+    int poll();
+
+    /** Advance the virtual clock to the next event and dispatch it
+     *
+     * @return          false if no event is pending
+     */
+    bool runNext();
+
+    /** Dispatch events until no event is pending
+     *
+     * @return          number of dispatched events
+     */
+    int run();
+
+    /** Check if a transfer or timer is pending */
+    bool isPending() const;
+
+    /** Get the number of dispatched callbacks */
+    uint32_t getCallbacks() const;
+
+    virtual int transfer(int address, const char *tx, int txLength, char *rx, int rxLength,
+                         SI7050BusCallback callback, void *context);
+    virtual int schedule(uint32_t us, SI7050BusCallback callback, void *context);
+    virtual uint32_t readUs();
+
+private:
+    struct Event {
+        bool                pending;
+        uint32_t            at;
+        SI7050BusCallback   callback;
+        void                *context;
+    };
+
+    SimI2CBus       &bus;
+    Event           transferEvent;
+    Event           timerEvent;
+    int             address;
+    const char      *tx;
+    int             txLength;
+    char            *rx;
+    int             rxLength;
+    uint32_t        callbacks;
+
+    Event *next();
+    void dispatch(Event &event);
+};
+
+#endif // SIM_ASYNC_BUS_H
@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file    SimI2CBus.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Simulated I2C bus implementation
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SimI2CBus.h"
+
+SimI2CBus::SimI2CBus()
+        :
+        clock(ownClock),
+        numDevices(0),
+        frequency(SIM_BUS_FREQUENCY),
+        failCount(0),
+        stuck(false),
+        stuckRecoverable(true),
+        recoveries(0),
+        transfers(0),
+        bytes(0) {
+    /* nothing to do */
+}
+
+SimI2CBus::SimI2CBus(SimClock &clock_obj)
+        :
+        clock(clock_obj),
+        numDevices(0),
+        frequency(SIM_BUS_FREQUENCY),
+        failCount(0),
+        stuck(false),
+        stuckRecoverable(true),
+        recoveries(0),
+        transfers(0),
+        bytes(0) {
+    /* nothing to do */
+}
+
+int SimI2CBus::attach(SimI2CDevice &device) {
+    if (numDevices >= SIM_MAX_DEVICES) {
+        return -1;
+    }
+    devices[numDevices++] = &device;
+    return 0;
+}
+
+void SimI2CBus::setFrequency(int hz) {
+    frequency = hz;
+}
+
+void SimI2CBus::failNext(int count) {
+    failCount = count;
+}
+
+void SimI2CBus::setStuck(bool stuck_, bool recoverable) {
+    stuck = stuck_;
+    stuckRecoverable = recoverable;
+}
+
+uint32_t SimI2CBus::getRecoveries() const {
+    return recoveries;
+}
+
+SimClock &SimI2CBus::getClock() {
+    return clock;
+}
+
+uint32_t SimI2CBus::getTransfers() const {
+    return transfers;
+}
+
+uint32_t SimI2CBus::getBytes() const {
+    return bytes;
+}
+
+SimI2CDevice *SimI2CBus::find(int address) {
+    for (int i = 0; i < numDevices; i++) {
+        if (devices[i]->matches(address)) {
+            return devices[i];
+        }
+    }
+    return NULL;
+}
+
+bool SimI2CBus::startTransfer() {
+    // start, address byte and stop, 9 clocks per byte
+    transfers++;
+    bytes++;
+    advanceClocks(2 + 9);
+
+    if (stuck) {
+        return false;
+    }
+    if (failCount > 0) {
+        failCount--;
+        return false;
+    }
+    return true;
+}
+
+int SimI2CBus::finishTransfer(int ack, int length) {
+    // a NACK ends the transfer after the address byte
+    if (ack == 0) {
+        bytes += length;
+        advanceClocks(9 * (uint32_t) length);
+    }
+    return ack;
+}
+
+void SimI2CBus::advanceClocks(uint32_t clocks) {
+    clock.advance((clocks * 1000000u + frequency - 1) / frequency);
+}
+
+int SimI2CBus::write(int address, const char *data, int length, bool repeated) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    SimI2CDevice *device = find(address);
+    (void) repeated;
+
+    if (!startTransfer() || device == NULL) {
+        return -1;
+    }
+    return finishTransfer(device->write(clock, address, data, length), length);
+}
+
+int SimI2CBus::read(int address, char *data, int length, bool repeated) {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+    SimI2CDevice *device = find(address);
+    (void) repeated;
+
+    if (!startTransfer() || device == NULL) {
+        return -1;
+    }
+    return finishTransfer(device->read(clock, address, data, length), length);
+}
+
+void SimI2CBus::waitUs(uint32_t us) {
+    clock.advance(us);
+}
+
+uint32_t SimI2CBus::readUs() {
+    return clock.readUs();
+}
+
+void SimI2CBus::lock() {
+    mutex.lock();
+}
+
+void SimI2CBus::unlock() {
+    mutex.unlock();
+}
+
+int SimI2CBus::recover() {
+    SI7050ScopedLock<SI7050Mutex> lock(mutex);
+
+    // up to 9 SCL pulses and a STOP
+    recoveries++;
+    advanceClocks(2 * SI70_RECOVER_CLOCKS + 2);
+    if (stuck && stuckRecoverable) {
+        stuck = false;
+    }
+    return stuck ? -1 : 0;
+}
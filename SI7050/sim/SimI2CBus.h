@@ -0,0 +1,173 @@
+/**
+ ******************************************************************************
+ * @file    SimI2CBus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Simulated I2C bus with a virtual clock, for host builds and tests
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef SIM_I2C_BUS_H
+#define SIM_I2C_BUS_H
+
+#include <atomic>
+
+#include "SI7050Bus.h"
+#include "SI7050Sync.h"
+
+#define SIM_MAX_DEVICES     8
+#define SIM_BUS_FREQUENCY   100000  // default SCL frequency in Hz
+
+/** SimClock class
+ *
+ *  Virtual time base, which only advances if somebody waits or transfers.
+ *  One clock can be shared between several simulated buses and threads.
+ */
+class SimClock
+{
+public:
+    SimClock() : now(0) {}
+
+    /** Get the current virtual time in us */
+    uint32_t readUs() const { return now.load(std::memory_order_relaxed); }
+
+    /** Advance the virtual time */
+    void advance(uint32_t us) { now.fetch_add(us, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> now;
+};
+
+
+/** SimI2CDevice class
+ *
+ *  Interface of a simulated I2C slave device
+ */
+class SimI2CDevice
+{
+public:
+
+    virtual ~SimI2CDevice() {}
+
+    /** Check if the device answers the 8 bit address */
+    virtual bool matches(int address) const = 0;
+
+    /** Handle a write transfer, return (0) on ACK, none (0) on NACK */
+    virtual int write(SimClock &clock, int address, const char *data, int length) = 0;
+
+    /** Handle a read transfer, return (0) on ACK, none (0) on NACK */
+    virtual int read(SimClock &clock, int address, char *data, int length) = 0;
+};
+
+
+/** SimI2CBus class
+ *
+ *  SI7050Bus implementation, which routes the transfers to simulated
+ *  devices and accounts the transfer time on the virtual clock.
+ *  The bus can be shared between threads, each transfer and each
+ *  locked sequence of transfers is atomic.
+ *
+ * @code
+ * SimI2CBus bus;
+ * SimSi7050 device;
+ * bus.attach(device);
+ *
+ * SI7050 sensor(bus);
+ * int temp = sensor.getTemperature();
+ * @endcode
+ */
+class SimI2CBus : public SI7050Bus
+{
+public:
+
+    /** Create a bus with its own virtual clock */
+    SimI2CBus();
+
+    /** Create a bus on a shared virtual clock
+     *
+     * @param clock_obj virtual clock (instance)
+     */
+    explicit SimI2CBus(SimClock &clock_obj);
+
+    /** Attach a simulated device to the bus
+     *
+     * @return          (0) if attached, (-1) if the bus is full
+     */
+    int attach(SimI2CDevice &device);
+
+    /** Set the SCL frequency, which is used for the transfer time */
+    void setFrequency(int hz);
+
+    /** Let the next transfers fail (NACK)
+     *
+     * @param count     number of transfers to fail
+     */
+    void failNext(int count);
+
+    /** Hold SDA low, all transfers fail until the bus is released
+     *
+     * @param stuck         true to hold the bus
+     * @param recoverable   true if recover() releases the bus (a slave
+     *                      holds SDA), false for a permanent fault
+     */
+    void setStuck(bool stuck, bool recoverable = true);
+
+    /** Get the number of bus recoveries */
+    uint32_t getRecoveries() const;
+
+    /** Get the virtual clock of the bus */
+    SimClock &getClock();
+
+    /** Get the number of transfers on the bus (including failed ones) */
+    uint32_t getTransfers() const;
+
+    /** Get the number of bytes on the bus (including address bytes),
+     *  a NACKed transfer ends after the address byte */
+    uint32_t getBytes() const;
+
+    virtual int write(int address, const char *data, int length, bool repeated);
+    virtual int read(int address, char *data, int length, bool repeated);
+    virtual void waitUs(uint32_t us);
+    virtual uint32_t readUs();
+    virtual void lock();
+    virtual void unlock();
+    virtual int recover();
+
+private:
+    SI7050Mutex     mutex;
+    SimClock        ownClock;
+    SimClock        &clock;
+    SimI2CDevice    *devices[SIM_MAX_DEVICES];
+    int             numDevices;
+    int             frequency;
+    int             failCount;
+    bool            stuck;
+    bool            stuckRecoverable;
+    uint32_t        recoveries;
+    uint32_t        transfers;
+    uint32_t        bytes;
+
+    SimI2CDevice *find(int address);
+    bool startTransfer();
+    int finishTransfer(int ack, int length);
+    void advanceClocks(uint32_t clocks);
+};
+
+#endif // SIM_I2C_BUS_H
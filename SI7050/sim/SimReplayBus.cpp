@@ -0,0 +1,119 @@
+/**
+ ******************************************************************************
+ * @file    SimReplayBus.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Replay of a recorded I2C trace
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include <string.h>
+#ifndef __MBED__
+#include <chrono>
+#include <thread>
+#endif
+
+#include "SimReplayBus.h"
+
+SimReplayBus::SimReplayBus(const uint8_t *trace, size_t length, bool realTime_)
+        :
+        reader(trace, length),
+        traceLength(length),
+        realTime(realTime_),
+        now(0),
+        replayed(0),
+        mismatches(0),
+        firstMismatch(-1) {
+    /* nothing to do */
+}
+
+uint32_t SimReplayBus::getReplayed() const {
+    return replayed;
+}
+
+uint32_t SimReplayBus::getMismatches() const {
+    return mismatches;
+}
+
+int SimReplayBus::getFirstMismatch() const {
+    return firstMismatch;
+}
+
+bool SimReplayBus::isDone() const {
+    return reader.getPosition() >= traceLength;
+}
+
+void SimReplayBus::advance(uint32_t us) {
+    now += us;
+    if (realTime && us) {
+#ifdef __MBED__
+        wait_us((int) us);
+#else
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+#endif
+    }
+}
+
+int SimReplayBus::replay(uint8_t flags, int address, const char *written, char *read, int length) {
+    SI7050TraceRecord record;
+    int index = (int) (replayed + mismatches);
+
+    if (reader.next(&record) != 0
+        || (record.flags & (SI70_TRACE_READ | SI70_TRACE_REPEATED | SI70_TRACE_RECOVER)) != flags
+        || record.address != (uint8_t) address || record.length != length
+        || (written && memcmp(record.data, written, length))) {
+        if (firstMismatch < 0) {
+            firstMismatch = index;
+        }
+        mismatches++;
+        return -1;
+    }
+
+    if ((int32_t) (record.timestamp - now) > 0) {
+        advance(record.timestamp - now);
+    }
+    advance(record.duration);
+    if (read && record.data) {
+        memcpy(read, record.data, length);
+    }
+    replayed++;
+
+    return record.flags & SI70_TRACE_NACK ? -1 : 0;
+}
+
+int SimReplayBus::write(int address, const char *data, int length, bool repeated) {
+    return replay(repeated ? SI70_TRACE_REPEATED : 0, address, data, NULL, length);
+}
+
+int SimReplayBus::read(int address, char *data, int length, bool repeated) {
+    return replay(SI70_TRACE_READ | (repeated ? SI70_TRACE_REPEATED : 0), address, NULL, data, length);
+}
+
+void SimReplayBus::waitUs(uint32_t us) {
+    advance(us);
+}
+
+uint32_t SimReplayBus::readUs() {
+    return now;
+}
+
+int SimReplayBus::recover() {
+    return replay(SI70_TRACE_RECOVER, 0, NULL, NULL, 0);
+}
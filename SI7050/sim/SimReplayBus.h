@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @file    SimReplayBus.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Replay of a recorded I2C trace
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef SIM_REPLAY_BUS_H
+#define SIM_REPLAY_BUS_H
+
+#include "SI7050Trace.h"
+
+/** SimReplayBus class
+ *
+ *  Answer the transactions of the driver from a trace, which was recorded
+ *  with SI7050TraceBus, e.g. on the target. Each transaction of the driver
+ *  has to match the next record (direction, address, repeated start,
+ *  length and written data), the read data and the ACK/NACK are taken
+ *  from the record. A transaction, which does not match, fails with a
+ *  NACK and is counted.
+ *
+ *  The virtual clock follows the recorded timing: a transaction does not
+ *  start before its recorded time and takes the recorded duration, waits
+ *  of the driver advance the clock. By default, the replay runs at full
+ *  speed, in real time mode it also sleeps the virtual time.
+ *
+ * @code
+ * SimReplayBus bus(trace, length);
+ * SI7050 sensor(bus);
+ *
+ * sensor.initialize();
+ * int temperature = sensor.getTemperature();
+ * bool same = bus.isDone() && bus.getMismatches() == 0;
+ * @endcode
+ */
+class SimReplayBus : public SI7050Bus
+{
+public:
+
+    /** Create a replay bus
+     *
+     * @param trace     recorded trace
+     * @param length    length of the trace in Bytes
+     * @param realTime  (option) sleep the recorded timing
+     */
+    SimReplayBus(const uint8_t *trace, size_t length, bool realTime = false);
+
+    /** Get the number of replayed transactions */
+    uint32_t getReplayed() const;
+
+    /** Get the number of transactions, which did not match the trace */
+    uint32_t getMismatches() const;
+
+    /** Get the index of the first transaction, which did not match the
+     *  trace, (-1) if all matched */
+    int getFirstMismatch() const;
+
+    /** Check if all records of the trace were replayed */
+    bool isDone() const;
+
+    virtual int write(int address, const char *data, int length, bool repeated);
+    virtual int read(int address, char *data, int length, bool repeated);
+    virtual void waitUs(uint32_t us);
+    virtual uint32_t readUs();
+    virtual int recover();
+
+private:
+    SI7050TraceReader   reader;
+    size_t              traceLength;
+    bool                realTime;
+    uint32_t            now;
+    uint32_t            replayed;
+    uint32_t            mismatches;
+    int                 firstMismatch;
+
+    int replay(uint8_t flags, int address, const char *written, char *read, int length);
+    void advance(uint32_t us);
+};
+
+#endif // SIM_REPLAY_BUS_H
@@ -0,0 +1,281 @@
+/**
+ ******************************************************************************
+ * @file    SimSi7050.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Software model of the SI7050 temperature sensor
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SimSi7050.h"
+
+static const unsigned char defaultSerial[8] = {0x00, 0x16, 0x4b, 0xe6, 0x32, 0xff, 0xff, 0xff};
+
+SimSi7050::SimSi7050(char slave_adr)
+        :
+        address(slave_adr),
+        userRegister(SIM_SI70_UR_DEFAULT),
+        firmware(SIM_SI70_FW_VERSION),
+        rawTemperature(0),
+        jitter(0),
+        seed(1),
+        response(RESP_NONE),
+        readyAt(0),
+        busyUntil(0),
+        resetting(false),
+        failCount(0),
+        corruptCount(0),
+        conversions(0) {
+    convTime[0] = SI70_CONV_TIME_11BIT_US * 6 / 10;   // typical conversion times
+    convTime[1] = SI70_CONV_TIME_12BIT_US * 6 / 10;
+    convTime[2] = SI70_CONV_TIME_13BIT_US * 6 / 10;
+    convTime[3] = SI70_CONV_TIME_14BIT_US * 6 / 10;
+    setSerial(defaultSerial);
+    setTemperature(2500);
+}
+
+void SimSi7050::setTemperature(int centiCelsius) {
+    // inverse of the temperature calculation, rounded up to the next code
+    int32_t raw = (int32_t) ((((int64_t) centiCelsius + 4685) * 65536 + 17571) / 17572);
+
+    if (raw < 0) {
+        raw = 0;
+    }
+    if (raw > 0xFFFF) {
+        raw = 0xFFFF;
+    }
+    rawTemperature = (uint16_t) raw;
+}
+
+void SimSi7050::setRawTemperature(uint16_t raw) {
+    rawTemperature = raw;
+}
+
+void SimSi7050::setConversionTime(int bits, uint32_t us) {
+    if (bits >= 11 && bits <= 14) {
+        convTime[bits - 11] = us;
+    }
+}
+
+void SimSi7050::setConversionJitter(uint32_t jitter_) {
+    jitter = jitter_;
+}
+
+void SimSi7050::setSerial(const unsigned char serial_[8]) {
+    for (int i = 0; i < 8; i++) {
+        serial[i] = serial_[i];
+    }
+}
+
+void SimSi7050::setFirmwareVersion(char version) {
+    firmware = version;
+}
+
+void SimSi7050::failNext(int count) {
+    failCount = count;
+}
+
+void SimSi7050::corruptNext(int count) {
+    corruptCount = count;
+}
+
+char SimSi7050::getUserRegister() const {
+    return userRegister;
+}
+
+uint32_t SimSi7050::getConversions() const {
+    return conversions;
+}
+
+bool SimSi7050::matches(int address_) const {
+    return (address_ & 0xFE) == (address & 0xFE);
+}
+
+int SimSi7050::resolution() const {
+    switch (userRegister & SI70_RES_MASK) {
+        case SI70_RES_11BIT:
+            return 11;
+        case SI70_RES_12BIT:
+            return 12;
+        case SI70_RES_13BIT:
+            return 13;
+        default:
+            return 14;
+    }
+}
+
+bool SimSi7050::busy(const SimClock &clock) {
+    if (resetting && (int32_t) (busyUntil - clock.readUs()) <= 0) {
+        resetting = false;
+    }
+    return resetting;
+}
+
+int SimSi7050::write(SimClock &clock, int address_, const char *data, int length) {
+    (void) address_;
+
+    if (failCount > 0) {
+        failCount--;
+        return -1;
+    }
+    // the sensor does not answer during reset and during a conversion
+    if (busy(clock) || length < 1) {
+        return -1;
+    }
+    if ((response == RESP_MEASURE) && (int32_t) (readyAt - clock.readUs()) > 0) {
+        return -1;
+    }
+
+    response = RESP_NONE;
+    switch ((unsigned char) data[0]) {
+        case SI70_RESET:
+            userRegister = SIM_SI70_UR_DEFAULT;
+            busyUntil = clock.readUs() + SIM_SI70_RESET_TIME_US;
+            resetting = true;
+            break;
+        case SI70_MEASURE:
+        case SI70_MEASURE_HOLD:
+            seed = seed * 1103515245u + 12345u;
+            readyAt = clock.readUs() + convTime[resolution() - 11]
+                      + (jitter ? (seed >> 8) % (jitter + 1) : 0);
+            response = ((unsigned char) data[0] == SI70_MEASURE) ? RESP_MEASURE : RESP_MEASURE_HOLD;
+            break;
+        case SI70_READ_UR:
+            response = RESP_USER_REGISTER;
+            break;
+        case SI70_WRITE_UR:
+            if (length < 2) {
+                return -1;
+            }
+            userRegister = data[1];
+            break;
+        case SI70_READ_FW_1:
+            if (length < 2 || (unsigned char) data[1] != SI70_READ_FW_2) {
+                return -1;
+            }
+            response = RESP_FIRMWARE;
+            break;
+        case SI70_READ_ID_11:
+            if (length < 2 || (unsigned char) data[1] != SI70_READ_ID_12) {
+                return -1;
+            }
+            response = RESP_ID_1;
+            break;
+        case SI70_READ_ID_21:
+            if (length < 2 || (unsigned char) data[1] != SI70_READ_ID_22) {
+                return -1;
+            }
+            response = RESP_ID_2;
+            break;
+        default:
+            return -1;
+    }
+
+    return 0;
+}
+
+int SimSi7050::read(SimClock &clock, int address_, char *data, int length) {
+    unsigned char buffer[8];
+    (void) address_;
+
+    if (failCount > 0) {
+        failCount--;
+        return -1;
+    }
+    if (busy(clock)) {
+        return -1;
+    }
+
+    switch (response) {
+        case RESP_MEASURE:
+        case RESP_MEASURE_HOLD:
+            return readMeasurement(clock, data, length);
+        case RESP_USER_REGISTER:
+            buffer[0] = (unsigned char) userRegister;
+            fill(data, length, buffer, 1);
+            break;
+        case RESP_FIRMWARE:
+            buffer[0] = (unsigned char) firmware;
+            fill(data, length, buffer, 1);
+            break;
+        case RESP_ID_1:
+            // SNA_3, CRC, SNA_2, CRC, SNA_1, CRC, SNA_0, CRC
+            for (int i = 0; i < 4; i++) {
+                buffer[2 * i] = serial[i];
+                buffer[2 * i + 1] = SI7050Crc::calc(&serial[i], 1, i ? buffer[2 * i - 1] : 0);
+            }
+            fill(data, length, buffer, 8);
+            break;
+        case RESP_ID_2:
+            // SNB_3, SNB_2, CRC, SNB_1, SNB_0, CRC
+            buffer[0] = serial[4];
+            buffer[1] = serial[5];
+            buffer[2] = SI7050Crc::calc(&serial[4], 2, 0);
+            buffer[3] = serial[6];
+            buffer[4] = serial[7];
+            buffer[5] = SI7050Crc::calc(&serial[6], 2, buffer[2]);
+            fill(data, length, buffer, 6);
+            break;
+        default:
+            return -1;
+    }
+
+    if (corruptCount > 0 && (response == RESP_ID_1 || response == RESP_ID_2)) {
+        corruptCount--;
+        data[0] ^= 0x04;
+    }
+
+    response = RESP_NONE;
+    return 0;
+}
+
+int SimSi7050::readMeasurement(SimClock &clock, char *data, int length) {
+    unsigned char buffer[3];
+    int bits = resolution();
+    uint16_t raw = (uint16_t) (rawTemperature & (0xFFFFu << (16 - bits)));
+
+    int32_t remaining = (int32_t) (readyAt - clock.readUs());
+    if (remaining > 0) {
+        if (response == RESP_MEASURE) {
+            return -1;  // no hold master mode: NACK until the conversion is done
+        }
+        clock.advance((uint32_t) remaining);  // hold master mode: clock stretching
+    }
+
+    buffer[0] = (unsigned char) (raw >> 8);
+    buffer[1] = (unsigned char) raw;
+    buffer[2] = SI7050Crc::calc(buffer, 2, 0);
+    if (corruptCount > 0) {
+        corruptCount--;
+        buffer[1] ^= 0x04;
+    }
+    fill(data, length, buffer, 3);
+
+    conversions++;
+    response = RESP_NONE;
+    return 0;
+}
+
+void SimSi7050::fill(char *data, int length, const unsigned char *src, int srcLength) {
+    // the sensor answers with 0xFF after the end of the data
+    for (int i = 0; i < length; i++) {
+        data[i] = (char) ((i < srcLength) ? src[i] : 0xFF);
+    }
+}
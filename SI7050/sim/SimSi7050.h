@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    SimSi7050.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Software model of the SI7050 temperature sensor
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef SIM_SI7050_H
+#define SIM_SI7050_H
+
+#include "SimI2CBus.h"
+#include "SI7050.h"
+
+#define SIM_SI70_UR_DEFAULT     0x3A    // user register value after power up and reset
+#define SIM_SI70_FW_VERSION     0x20    // firmware version 2.0
+#define SIM_SI70_RESET_TIME_US  SI70_RESET_TIME_US  // the sensor does not answer after a reset
+
+/** SimSi7050 class
+ *
+ *  Simulated SI7050 sensor, which speaks the command set of the device:
+ *  reset, user register read/write, measurement in hold and no hold
+ *  master mode, firmware version and electronic ID including CRC.
+ *  The conversion latency and faults can be configured.
+ */
+class SimSi7050 : public SimI2CDevice
+{
+public:
+
+    /** Create a simulated sensor
+     *
+     * @param slave_adr (option) I2C-bus address (default: 0x40)
+     */
+    explicit SimSi7050(char slave_adr = (char) SI70_ADDRESS);
+
+    /** Set the temperature the sensor measures
+     *
+     * @param centiCelsius  temperature in 0.01°C
+     */
+    void setTemperature(int centiCelsius);
+
+    /** Set the raw 16 bit temperature code the sensor measures */
+    void setRawTemperature(uint16_t raw);
+
+    /** Set the conversion time of a resolution
+     *
+     * @param bits          resolution in bits (11, 12, 13 or 14)
+     * @param us            conversion time in us
+     */
+    void setConversionTime(int bits, uint32_t us);
+
+    /** Add a pseudo random extra time of 0 to jitter us to every conversion */
+    void setConversionJitter(uint32_t jitter);
+
+    /** Set the 8 Byte serial number (electronic ID) */
+    void setSerial(const unsigned char serial[8]);
+
+    /** Set the firmware version */
+    void setFirmwareVersion(char version);
+
+    /** Let the next transfers to the sensor fail (NACK) */
+    void failNext(int count);
+
+    /** Flip a bit in the next measurement or ID reads, so the CRC does not match */
+    void corruptNext(int count);
+
+    /** Get the current user register value */
+    char getUserRegister() const;
+
+    /** Get the number of finished conversions */
+    uint32_t getConversions() const;
+
+    virtual bool matches(int address) const;
+    virtual int write(SimClock &clock, int address, const char *data, int length);
+    virtual int read(SimClock &clock, int address, char *data, int length);
+
+private:
+    enum Response {
+        RESP_NONE,
+        RESP_MEASURE,
+        RESP_MEASURE_HOLD,
+        RESP_USER_REGISTER,
+        RESP_FIRMWARE,
+        RESP_ID_1,
+        RESP_ID_2
+    };
+
+    char        address;
+    char        userRegister;
+    char        firmware;
+    unsigned char serial[8];
+    uint16_t    rawTemperature;
+    uint32_t    convTime[4];
+    uint32_t    jitter;
+    uint32_t    seed;
+    Response    response;
+    uint32_t    readyAt;
+    uint32_t    busyUntil;
+    bool        resetting;      // busyUntil is valid, the clock wraps after 71 minutes
+    int         failCount;
+    int         corruptCount;
+    uint32_t    conversions;
+
+    int resolution() const;
+    bool busy(const SimClock &clock);
+    int readMeasurement(SimClock &clock, char *data, int length);
+    static void fill(char *data, int length, const unsigned char *src, int srcLength);
+};
+
+#endif // SIM_SI7050_H
@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    SimTca9548a.cpp
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Software model of the TCA9548A I2C multiplexer
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#include "SimTca9548a.h"
+
+SimTca9548a::SimTca9548a(char slave_adr)
+        :
+        address(slave_adr),
+        control(0) {
+    for (int i = 0; i < TCA9548A_CHANNELS; i++) {
+        numDevices[i] = 0;
+    }
+}
+
+int SimTca9548a::attach(int channel, SimI2CDevice &device) {
+    if (channel < 0 || channel >= TCA9548A_CHANNELS || numDevices[channel] >= SIM_MUX_DEVICES) {
+        return -1;
+    }
+    devices[channel][numDevices[channel]++] = &device;
+    return 0;
+}
+
+char SimTca9548a::getControl() const {
+    return control;
+}
+
+SimI2CDevice *SimTca9548a::find(int address_) const {
+    for (int channel = 0; channel < TCA9548A_CHANNELS; channel++) {
+        if (!(control & (1 << channel))) {
+            continue;
+        }
+        for (int i = 0; i < numDevices[channel]; i++) {
+            if (devices[channel][i]->matches(address_)) {
+                return devices[channel][i];
+            }
+        }
+    }
+    return NULL;
+}
+
+bool SimTca9548a::matches(int address_) const {
+    return ((address_ & 0xFE) == (address & 0xFE)) || (find(address_) != NULL);
+}
+
+int SimTca9548a::write(SimClock &clock, int address_, const char *data, int length) {
+    if ((address_ & 0xFE) == (address & 0xFE)) {
+        if (length < 1) {
+            return -1;
+        }
+        control = data[length - 1];
+        return 0;
+    }
+
+    SimI2CDevice *device = find(address_);
+    return device ? device->write(clock, address_, data, length) : -1;
+}
+
+int SimTca9548a::read(SimClock &clock, int address_, char *data, int length) {
+    if ((address_ & 0xFE) == (address & 0xFE)) {
+        for (int i = 0; i < length; i++) {
+            data[i] = control;
+        }
+        return 0;
+    }
+
+    SimI2CDevice *device = find(address_);
+    return device ? device->read(clock, address_, data, length) : -1;
+}
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    SimTca9548a.h
+ * @author  ubirch GmbH
+ * @version V1.0.0
+ * @date    16 October 2026
+ * @brief   Software model of the TCA9548A I2C multiplexer
+ ******************************************************************************
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+
+#ifndef SIM_TCA9548A_H
+#define SIM_TCA9548A_H
+
+#include "SimI2CBus.h"
+#include "SI7050Mux.h"
+
+#define SIM_MUX_DEVICES     4   // devices per channel
+
+/** SimTca9548a class
+ *
+ *  Simulated multiplexer, which routes the transfers to the devices
+ *  attached to the enabled channels.
+ *
+ * @code
+ * SimI2CBus bus;
+ * SimTca9548a mux;
+ * SimSi7050 device0, device1;
+ * bus.attach(mux);
+ * mux.attach(0, device0);
+ * mux.attach(1, device1);
+ * @endcode
+ */
+class SimTca9548a : public SimI2CDevice
+{
+public:
+
+    /** Create a simulated multiplexer
+     *
+     * @param slave_adr (option) I2C-bus address (default: 0x70)
+     */
+    explicit SimTca9548a(char slave_adr = (char) TCA9548A_ADDRESS);
+
+    /** Attach a simulated device to a channel
+     *
+     * @return          (0) if attached, (-1) if the channel is full
+     */
+    int attach(int channel, SimI2CDevice &device);
+
+    /** Get the control register (one bit per enabled channel) */
+    char getControl() const;
+
+    virtual bool matches(int address) const;
+    virtual int write(SimClock &clock, int address, const char *data, int length);
+    virtual int read(SimClock &clock, int address, char *data, int length);
+
+private:
+    char            address;
+    char            control;
+    SimI2CDevice    *devices[TCA9548A_CHANNELS][SIM_MUX_DEVICES];
+    int             numDevices[TCA9548A_CHANNELS];
+
+    SimI2CDevice *find(int address) const;
+};
+
+#endif // SIM_TCA9548A_H
@@ -0,0 +1,198 @@
+/*
+ * SI7050 Sensor library tests of the raw domain alarm engine.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Alarm.h"
+#include "SI7050.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+// smallest 14 bit raw code, which converts to at least a temperature in 0.01°C
+static uint16_t rawOf(int centiCelsius) {
+    return (uint16_t) SI7050Alarm::rawAtLeast(centiCelsius, SI70_MASK_14BIT);
+}
+
+struct Events {
+    int count;
+    int alarm;
+    bool active;
+    uint16_t raw;
+};
+
+static void changed(void *context, int alarm, bool active, uint16_t raw) {
+    Events *events = (Events *) context;
+
+    events->count++;
+    events->alarm = alarm;
+    events->active = active;
+    events->raw = raw;
+}
+
+/*
+ * Every raw code is compared like the converted temperature.
+ */
+void TestAlarm_inverse() {
+    const int thresholds[] = {-4686, -4685, -4684, -1000, 0, 1, 2500, 2501, 8000, 12886, 12887, 20000};
+
+    for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++) {
+        uint32_t limit = SI7050Alarm::rawAtLeast(thresholds[t]);
+        for (uint32_t raw = 0; raw <= 0xFFFF; raw++) {
+            bool reached = Si705xCentiCelsius::fromRaw((uint16_t) raw) >= thresholds[t];
+            if (reached != (raw >= limit)) {
+                TEST_FAIL_MESSAGE("raw threshold differs from the conversion");
+                return;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, SI7050Alarm::rawAtLeast(-10000));
+    TEST_ASSERT_EQUAL_UINT32(0x10000, SI7050Alarm::rawAtLeast(20000));
+
+    // the same with the codes of a resolution only
+    const uint16_t masks[] = {SI70_MASK_14BIT, SI70_MASK_11BIT};
+    for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); m++) {
+        for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++) {
+            uint32_t limit = SI7050Alarm::rawAtLeast(thresholds[t], masks[m]);
+            for (uint32_t raw = 0; raw <= 0xFFFF; raw += (uint16_t) ~masks[m] + 1u) {
+                bool reached = Si705xCentiCelsius::fromRaw((uint16_t) raw) >= thresholds[t];
+                if (reached != (raw >= limit)) {
+                    TEST_FAIL_MESSAGE("raw threshold of the resolution differs from the conversion");
+                    return;
+                }
+            }
+            TEST_ASSERT_EQUAL_UINT32(0, limit & (uint16_t) ~masks[m]);
+        }
+    }
+}
+
+void TestAlarm_hysteresis() {
+    Events events = {0, -1, false, 0};
+    SI7050Alarm alarms(changed, &events);
+
+    TEST_ASSERT_EQUAL_INT(0, alarms.add(8000, 200, SI70_ALARM_ABOVE));
+    TEST_ASSERT_EQUAL_INT(1, alarms.add(-1000, 50, SI70_ALARM_BELOW));
+    TEST_ASSERT_EQUAL_INT(2, alarms.getCount());
+
+    // the last code below 80°C, then the first one at 80°C: one callback
+    uint16_t hot = rawOf(8000);
+    alarms.update(hot - 4);
+    TEST_ASSERT_EQUAL_INT(0, events.count);
+    TEST_ASSERT_EQUAL_UINT32(1, alarms.update(hot));
+    TEST_ASSERT_EQUAL_INT(1, events.count);
+    TEST_ASSERT_EQUAL_INT(0, events.alarm);
+    TEST_ASSERT_TRUE(events.active);
+    TEST_ASSERT_EQUAL_UINT16(hot, events.raw);
+    alarms.update(rawOf(8100));
+    TEST_ASSERT_EQUAL_INT(1, events.count);
+
+    // within the hysteresis the alarm stays active, it clears below 78°C
+    alarms.update(rawOf(7800));
+    TEST_ASSERT_TRUE(alarms.isActive(0));
+    alarms.update(rawOf(7800) - 4);
+    TEST_ASSERT_FALSE(alarms.isActive(0));
+    TEST_ASSERT_EQUAL_INT(2, events.count);
+    TEST_ASSERT_FALSE(events.active);
+
+    // below: active at or below -10°C, cleared above -9.5°C
+    alarms.update(rawOf(-999));
+    TEST_ASSERT_EQUAL_UINT32(0, alarms.getActive());
+    alarms.update(rawOf(-999) - 4);
+    TEST_ASSERT_EQUAL_UINT32(2, alarms.getActive());
+    TEST_ASSERT_EQUAL_INT(1, events.alarm);
+    alarms.update(rawOf(-949) - 4);
+    TEST_ASSERT_TRUE(alarms.isActive(1));
+    alarms.update(rawOf(-949));
+    TEST_ASSERT_FALSE(alarms.isActive(1));
+    TEST_ASSERT_EQUAL_INT(4, events.count);
+
+    // a new threshold keeps the state
+    alarms.update(hot);
+    TEST_ASSERT_EQUAL_INT(0, alarms.setThreshold(0, 9000, 0));
+    TEST_ASSERT_TRUE(alarms.isActive(0));
+    alarms.update(rawOf(9000) - 4);
+    TEST_ASSERT_FALSE(alarms.isActive(0));
+
+    alarms.update(rawOf(9500));
+    alarms.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, alarms.getActive());
+}
+
+void TestAlarm_limits() {
+    SI7050Alarm alarms;
+
+    TEST_ASSERT_EQUAL_INT(-1, alarms.add(0, 0, 2));
+    TEST_ASSERT_EQUAL_INT(-1, alarms.add(0, -1, SI70_ALARM_ABOVE));
+    TEST_ASSERT_EQUAL_INT(-1, alarms.setThreshold(0, 0, 0));
+    for (int i = 0; i < SI70_ALARM_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(i, alarms.add(i * 100, 0, SI70_ALARM_ABOVE));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, alarms.add(0, 0, SI70_ALARM_ABOVE));
+    TEST_ASSERT_FALSE(alarms.isActive(SI70_ALARM_MAX));
+
+    // without a callback, all alarms at once
+    TEST_ASSERT_EQUAL_UINT32((1u << SI70_ALARM_MAX) - 1, alarms.update(0xFFFC));
+}
+
+/*
+ * The alarm engine on the samples of the sensor.
+ */
+void TestAlarm_sensor() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Events events = {0, -1, false, 0};
+    SI7050Alarm alarms(changed, &events);
+    SI7050Sample sample;
+    bus.attach(device);
+
+    alarms.add(3000, 100, SI70_ALARM_ABOVE);
+    device.setRawTemperature(rawOf(3000));
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureSample(&sample));
+    alarms.update(sample.raw & sensor.getRawMask());
+    TEST_ASSERT_TRUE(events.active);
+    TEST_ASSERT_TRUE(Si705xCentiCelsius::fromRaw((uint16_t) (sample.raw & sensor.getRawMask())) >= 3000);
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 alarm raw thresholds-0", TestAlarm_inverse, greentea_failure_handler),
+Case("SI7050 alarm hysteresis-0", TestAlarm_hysteresis, greentea_failure_handler),
+Case("SI7050 alarm limits-0", TestAlarm_limits, greentea_failure_handler),
+Case("SI7050 alarm sensor samples-0", TestAlarm_sensor, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,223 @@
+/*
+ * SI7050 Sensor library tests of the asynchronous driver against the
+ * simulated asynchronous bus.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <string.h>
+
+#include "SI7050Async.h"
+#include "SimAsyncBus.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+struct Result {
+    int calls;
+    int status;
+    char data[8];
+};
+
+static void onDone(void *context, int status, const char *data) {
+    Result *result = (Result *) context;
+
+    result->calls++;
+    result->status = status;
+    if (data != NULL) {
+        memcpy(result->data, data, sizeof(result->data));
+    }
+}
+
+void TestAsync_measure() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    bus.attach(device);
+
+    device.setTemperature(2247);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    TEST_ASSERT_TRUE(sensor.isBusy());
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, sensor.measureTemperature(onDone, &result), "second operation started");
+
+    // nothing happens on the bus, until the event loop runs
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getTransfers());
+    TEST_ASSERT_EQUAL_INT(0, result.calls);
+
+    async.run();
+    TEST_ASSERT_EQUAL_INT(1, result.calls);
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_FALSE(sensor.isBusy());
+    uint16_t raw = (uint16_t) (((unsigned char) result.data[0] << 8) | (unsigned char) result.data[1]);
+    TEST_ASSERT_INT_WITHIN(1, 2247, Si705xCentiCelsius::fromRaw((uint16_t) (raw & SI70_MASK_14BIT)));
+
+    // start, timer and read
+    TEST_ASSERT_EQUAL_UINT32(2, bus.getTransfers());
+    TEST_ASSERT_EQUAL_UINT32(3, async.getCallbacks());
+}
+
+void TestAsync_poll() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    bus.attach(device);
+
+    // the conversion takes longer than the maximum time, the read is polled
+    device.setConversionTime(14, SI70_CONV_TIME_14BIT_US + 2 * SI70_POLL_INTERVAL_US);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(1, result.calls);
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_TRUE_MESSAGE(bus.getTransfers() > 2, "read not polled");
+
+    // timeout after twice the conversion time
+    device.setConversionTime(14, 3 * SI70_CONV_TIME_14BIT_US);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(2, result.calls);
+    TEST_ASSERT_EQUAL_INT(-1, result.status);
+    TEST_ASSERT_FALSE(async.isPending());
+}
+
+void TestAsync_integrity() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    bus.attach(device);
+
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    device.corruptNext(SI70_CRC_RETRIES);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_EQUAL_UINT32(1 + SI70_CRC_RETRIES, device.getConversions());
+
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(SI70_ERROR_CRC, result.status);
+    TEST_ASSERT_EQUAL_INT(2, result.calls);
+}
+
+void TestAsync_initialize() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(-1, sensor.setResolution(10));
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(11));
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize(onDone, &result));
+    TEST_ASSERT_EQUAL_INT(-1, sensor.setResolution(12));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_EQUAL_HEX8((SIM_SI70_UR_DEFAULT & ~SI70_RES_MASK) | SI70_RES_11BIT, device.getUserRegister());
+
+    // the 11 bit conversion is shorter
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_TRUE(bus.readUs() - start < SI70_CONV_TIME_12BIT_US);
+
+    // bus error
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(-1, result.status);
+    TEST_ASSERT_EQUAL_INT(3, result.calls);
+}
+
+void TestAsync_serial() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    const unsigned char serial[8] = {0x00, 0x16, 0x4b, 0xe6, 0x32, 0xff, 0xff, 0xff};
+    bus.attach(device);
+
+    device.setSerial(serial);
+    TEST_ASSERT_EQUAL_INT(0, sensor.getSerial(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(serial, result.data, 8);
+
+    device.corruptNext(1);
+    TEST_ASSERT_EQUAL_INT(0, sensor.getSerial(onDone, &result));
+    async.run();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, result.status, "corrupted serial not detected");
+}
+
+void TestAsync_poll_loop() {
+    SimI2CBus bus;
+    SimAsyncBus async(bus);
+    SimSi7050 device;
+    SI7050Async sensor(async);
+    Result result = {};
+    int idle = 0;
+    bus.attach(device);
+
+    // the application works, while the conversion runs
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(onDone, &result));
+    while (sensor.isBusy()) {
+        async.poll();
+        bus.waitUs(100);
+        idle++;
+    }
+    TEST_ASSERT_EQUAL_INT(1, result.calls);
+    TEST_ASSERT_EQUAL_INT(0, result.status);
+    TEST_ASSERT_TRUE(idle >= SI70_CONV_TIME_14BIT_US / 100);
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 async measure-0", TestAsync_measure, greentea_failure_handler),
+Case("SI7050 async poll until ready-0", TestAsync_poll, greentea_failure_handler),
+Case("SI7050 async integrity mode-0", TestAsync_integrity, greentea_failure_handler),
+Case("SI7050 async initialize-0", TestAsync_initialize, greentea_failure_handler),
+Case("SI7050 async serial-0", TestAsync_serial, greentea_failure_handler),
+Case("SI7050 async event loop-0", TestAsync_poll_loop, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,111 @@
+/*
+ * SI7050 batched conversion tests.
+ *
+ * These tests do not need the real sensor and also run on the host,
+ * see host/CMakeLists.txt.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+
+#include "SI7050Convert.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define RANGE   65536
+#define CHUNK   256     // the range is converted in chunks, it fits into the RAM of small targets
+
+static uint8_t raw[2 * CHUNK];
+static int16_t scalar[CHUNK];
+static int16_t batch[CHUNK];
+
+// all raw values against calcTemperature() for all resolutions (see TestSi_calculationRange)
+void TestConvert_range() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    const int bits[] = {11, 12, 13, 14};
+    const uint16_t masks[] = {SI70_MASK_11BIT, SI70_MASK_12BIT, SI70_MASK_13BIT, SI70_MASK_14BIT};
+    bus.attach(device);
+
+    for (int r = 0; r < 4; r++) {
+        TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(bits[r]));
+
+        for (int start = 0; start < RANGE; start += CHUNK) {
+            for (int i = 0; i < CHUNK; i++) {
+                raw[2 * i] = (uint8_t) ((start + i) >> 8);
+                raw[2 * i + 1] = (uint8_t) (start + i);
+            }
+            SI7050Convert::convertScalar(raw, scalar, CHUNK, masks[r]);
+            SI7050Convert::convert(raw, batch, CHUNK, masks[r]);
+
+            for (int i = 0; i < CHUNK; i++) {
+                int expect = sensor.calcTemperature((const char *) &raw[2 * i]);
+                if (expect != scalar[i] || expect != batch[i]) {
+                    printf("raw 0x%04x, %d bit: expected %d, scalar %d, %s %d\n", start + i, bits[r], expect,
+                           scalar[i], SI7050Convert::path(), batch[i]);
+                    TEST_FAIL_MESSAGE("conversion differs from calcTemperature()");
+                }
+            }
+        }
+    }
+}
+
+// buffers, which are no multiple of the SIMD width and not aligned
+void TestConvert_tail() {
+    for (size_t count = 0; count < 40; count++) {
+        for (size_t offset = 0; offset < 3; offset++) {
+            for (size_t i = 0; i < 2 * count; i++) {
+                raw[offset + i] = (uint8_t) rand();
+            }
+            batch[offset + count] = 0x5555;
+            SI7050Convert::convertScalar(raw + offset, scalar + offset, count);
+            SI7050Convert::convert(raw + offset, batch + offset, count);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(scalar + offset, batch + offset, count * sizeof(int16_t),
+                                                  "SIMD and scalar path differ");
+            TEST_ASSERT_EQUAL_INT_MESSAGE(0x5555, batch[offset + count], "wrote behind the buffer");
+        }
+    }
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 convert complete range-0", TestConvert_range, greentea_failure_handler),
+Case("SI7050 convert unaligned tail-0", TestConvert_tail, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
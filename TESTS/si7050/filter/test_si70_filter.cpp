@@ -0,0 +1,185 @@
+/*
+ * SI7050 Sensor library tests of the raw sample filters.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+#include <algorithm>
+
+#include "SI7050Filter.h"
+#include "SI7050Convert.h"
+#include "SI7050Alarm.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+// smallest 14 bit raw code, which converts to at least a temperature in 0.01°C
+static uint16_t rawOf(int centiCelsius) {
+    return (uint16_t) SI7050Alarm::rawAtLeast(centiCelsius, SI70_MASK_14BIT);
+}
+
+void TestFilter_oversample() {
+    SI7050Oversample<4> filter;
+    const uint16_t in[8] = {100, 104, 108, 112, 0xFFFC, 0xFFFC, 0xFFFC, 0xFFF8};
+    uint16_t out = 0;
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_FALSE(filter.update(in[i], &out));
+    }
+    TEST_ASSERT_TRUE(filter.update(in[3], &out));
+    TEST_ASSERT_EQUAL_UINT16(106, out);
+
+    // the sum does not overflow at the end of the range
+    for (int i = 4; i < 7; i++) {
+        TEST_ASSERT_FALSE(filter.update(in[i], &out));
+    }
+    TEST_ASSERT_TRUE(filter.update(in[7], &out));
+    TEST_ASSERT_EQUAL_UINT16(0xFFFB, out);
+
+    filter.update(1000, &out);
+    filter.reset();
+    TEST_ASSERT_FALSE(filter.update(8, &out));
+}
+
+void TestFilter_ema() {
+    SI7050Ema<2> filter;
+    uint16_t out = 0;
+
+    // the first sample initializes the average
+    TEST_ASSERT_TRUE(filter.update(1000, &out));
+    TEST_ASSERT_EQUAL_UINT16(1000, out);
+    // a constant input is output exactly
+    for (int i = 0; i < 10; i++) {
+        filter.update(1000, &out);
+        TEST_ASSERT_EQUAL_UINT16(1000, out);
+    }
+
+    // alpha 1/4: 1000 + (2000 - 1000) / 4
+    filter.update(2000, &out);
+    TEST_ASSERT_EQUAL_UINT16(1250, out);
+    filter.update(2000, &out);
+    TEST_ASSERT_INT_WITHIN(1, 1438, out);
+    for (int i = 0; i < 100; i++) {
+        filter.update(2000, &out);
+    }
+    TEST_ASSERT_EQUAL_UINT16(2000, out);
+
+    // no overflow at the end of the range with the smallest alpha
+    SI7050Ema<15> slow;
+    for (int i = 0; i < 1000; i++) {
+        slow.update(0xFFFC, &out);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0xFFFC, out);
+
+    filter.reset();
+    filter.update(4, &out);
+    TEST_ASSERT_EQUAL_UINT16(4, out);
+}
+
+// compare the median with a sort of the window
+template<unsigned N>
+static void checkMedian(int values, int samples) {
+    SI7050Median<N> median;
+    uint16_t window[N], sorted[N];
+    uint16_t out = 0;
+
+    for (int i = 0; i < samples; i++) {
+        uint16_t in = (uint16_t) (rand() % values);
+        median.update(in, &out);
+        window[i % N] = in;
+
+        int n = i < (int) N ? i + 1 : (int) N;
+        std::copy(window, window + n, sorted);
+        std::sort(sorted, sorted + n);
+        TEST_ASSERT_EQUAL_UINT16(sorted[(n - 1) / 2], out);
+    }
+}
+
+void TestFilter_median() {
+    SI7050Median<5> filter;
+    uint16_t out = 0;
+
+    // partial window
+    filter.update(10, &out);
+    TEST_ASSERT_EQUAL_UINT16(10, out);
+    filter.update(30, &out);
+    filter.update(20, &out);
+    TEST_ASSERT_EQUAL_UINT16(20, out);
+
+    // a spike is removed
+    filter.update(20, &out);
+    filter.update(9000, &out);
+    TEST_ASSERT_EQUAL_UINT16(20, out);
+
+    // against a sort of the window, with many equal values
+    srand(3);
+    checkMedian<7>(16, 2000);
+    checkMedian<1>(16, 100);
+    checkMedian<31>(65536, 2000);
+    checkMedian<255>(64, 2000);
+}
+
+void TestFilter_chain() {
+    SI7050FilterChain<SI7050Median<3>, SI7050FilterChain<SI7050Oversample<4>, SI7050Ema<2> > > filter;
+    uint16_t out = 0;
+    int outputs = 0;
+
+    // noisy readings of 25°C with a spike each 10 samples
+    srand(5);
+    for (int i = 0; i < 400; i++) {
+        uint16_t raw = (uint16_t) ((rawOf(2500) + (rand() % 9 - 4) * 4) & SI70_MASK_14BIT);
+        if (i % 10 == 0) {
+            raw = rawOf(8000);
+        }
+        if (filter.update(raw, &out)) {
+            outputs++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(100, outputs);
+    TEST_ASSERT_INT_WITHIN(2, 2500, SI7050Convert::toCentiCelsius(out));
+
+    filter.reset();
+    TEST_ASSERT_FALSE(filter.update(rawOf(2500), &out));
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 filter oversampling-0", TestFilter_oversample, greentea_failure_handler),
+Case("SI7050 filter moving average-0", TestFilter_ema, greentea_failure_handler),
+Case("SI7050 filter median-0", TestFilter_median, greentea_failure_handler),
+Case("SI7050 filter chain-0", TestFilter_chain, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,148 @@
+/*
+ * SI7050 group (multi-sensor scheduler) tests against simulated sensors.
+ *
+ * These tests do not need the real sensor and also run on the host,
+ * see host/CMakeLists.txt.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Group.h"
+#include "SimSi7050.h"
+#include "SimTca9548a.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define CONV_TIME_US    7000
+
+// two buses on the same time base, bus A with a multiplexer and 3 sensors
+struct Fixture {
+    SimClock clock;
+    SimI2CBus busA;
+    SimI2CBus busB;
+    SimTca9548a simMux;
+    SimSi7050 device[4];
+    TCA9548A mux;
+    SI7050 sensor0, sensor1, sensor2, sensor3;
+
+    Fixture() : busA(clock), busB(clock), mux(busA),
+                sensor0(busA), sensor1(busA), sensor2(busA), sensor3(busB) {
+        busA.attach(simMux);
+        busB.attach(device[3]);
+        for (int i = 0; i < 4; i++) {
+            device[i].setConversionTime(14, CONV_TIME_US);
+            device[i].setTemperature(2000 + 100 * i);
+            if (i < 3) {
+                simMux.attach(i, device[i]);
+            }
+        }
+    }
+};
+
+void TestGroup_sweep() {
+    Fixture f;
+    SI7050Group group;
+    int temperatures[4];
+
+    TEST_ASSERT_EQUAL_INT(0, group.add(f.sensor0, &f.mux, 0));
+    TEST_ASSERT_EQUAL_INT(0, group.add(f.sensor1, &f.mux, 1));
+    TEST_ASSERT_EQUAL_INT(0, group.add(f.sensor2, &f.mux, 2));
+    TEST_ASSERT_EQUAL_INT(0, group.add(f.sensor3));
+    TEST_ASSERT_EQUAL_INT(4, group.getCount());
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, group.sweep(temperatures), "sweep failed");
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_INT_WITHIN(1, 2000 + 100 * i, temperatures[i]);
+    }
+
+    // the conversions overlap: far less than one conversion time per sensor
+    TEST_ASSERT_MESSAGE(group.getSweepTime() >= f.sensor0.getConversionTime(), "sweep shorter than a conversion");
+    TEST_ASSERT_MESSAGE(group.getSweepTime() < f.sensor0.getConversionTime() + 3000, "conversions not overlapped");
+    TEST_ASSERT_EQUAL_UINT32(1, group.getSweeps());
+}
+
+void TestGroup_serialComparison() {
+    Fixture f;
+    SI7050 *sensors[4] = {&f.sensor0, &f.sensor1, &f.sensor2, &f.sensor3};
+
+    uint32_t start = f.clock.readUs();
+    for (int i = 0; i < 4; i++) {
+        if (i < 3) {
+            f.mux.select(i);
+        }
+        TEST_ASSERT_INT_WITHIN(1, 2000 + 100 * i, sensors[i]->getTemperature());
+    }
+    uint32_t serial = f.clock.readUs() - start;
+    TEST_ASSERT_MESSAGE(serial >= 4 * f.sensor0.getConversionTime(), "serial measurement faster than expected");
+}
+
+void TestGroup_failedSensor() {
+    Fixture f;
+    SI7050Group group;
+    int temperatures[2];
+
+    group.add(f.sensor0, &f.mux, 0);
+    group.add(f.sensor1, &f.mux, 5);    // no sensor on this channel
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, group.sweep(temperatures), "failed sensor not reported");
+    TEST_ASSERT_INT_WITHIN(1, 2000, temperatures[0]);
+    TEST_ASSERT_EQUAL_INT(-32768, temperatures[1]);
+}
+
+void TestGroup_mixedResolution() {
+    Fixture f;
+    SI7050Group group;
+    int temperatures[2];
+
+    f.mux.select(0);
+    f.sensor0.setResolution(14);
+    f.mux.select(1);
+    f.sensor1.setResolution(11);
+    group.add(f.sensor0, &f.mux, 0);
+    group.add(f.sensor1, &f.mux, 1);
+    TEST_ASSERT_EQUAL_INT(0, group.sweep(temperatures));
+    TEST_ASSERT_INT_WITHIN(1, 2000, temperatures[0]);
+    TEST_ASSERT_INT_WITHIN(20, 2100, temperatures[1]);
+    TEST_ASSERT_MESSAGE(group.getSweepTime() < f.sensor0.getConversionTime() + 2000, "fast sensor delayed the sweep");
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 group sweep-0", TestGroup_sweep, greentea_failure_handler),
+Case("SI7050 group serial comparison-0", TestGroup_serialComparison, greentea_failure_handler),
+Case("SI7050 group failed sensor-0", TestGroup_failedSensor, greentea_failure_handler),
+Case("SI7050 group mixed resolution-0", TestGroup_mixedResolution, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
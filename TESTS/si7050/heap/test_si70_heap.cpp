@@ -0,0 +1,156 @@
+/*
+ * SI7050 Sensor library tests, that the driver works without the heap
+ * and without a vtable.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+#include <type_traits>
+
+#include "SI7050Group.h"
+#include "SI7050Sampler.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#ifdef __MBED__
+#define SI7050_SDA p26
+#define SI7050_SCL p25
+#endif
+
+using namespace utest::v1;
+
+static_assert(!std::is_polymorphic<SI7050Device>::value, "SI7050Device must not have a vtable");
+static_assert(!std::is_polymorphic<SI7050>::value, "SI7050 must not have a vtable");
+
+// count the allocations of the whole program
+static int allocations = 0;
+
+// the target builds without exceptions, a failed allocation ends the test
+void *operator new(size_t size) {
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        abort();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+static void sampled(void *, const SI7050Sample *) {}
+
+void TestHeap_sensor() {
+    int before = allocations;
+    {
+        SimI2CBus bus;
+        SimSi7050 device;
+        SI7050 sensor(bus);
+        unsigned char serial[8];
+        bus.attach(device);
+
+        TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature());
+        TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(12));
+        TEST_ASSERT_EQUAL_INT(0, sensor.getSerial(serial));
+        sensor.setCompletionMode(SI70_COMPLETION_POLL);
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature());
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature(1000000));
+    }
+    TEST_ASSERT_EQUAL_INT(before, allocations);
+}
+
+void TestHeap_helpers() {
+    int before = allocations;
+    {
+        SimI2CBus bus;
+        SimSi7050 device;
+        SI7050 sensor(bus);
+        SI7050Group group;
+        SI7050Sampler sampler(sensor, 20000, sampled, NULL);
+        int temperatures[1];
+        bus.attach(device);
+
+        group.add(sensor);
+        TEST_ASSERT_EQUAL_INT(0, group.sweep(temperatures));
+        TEST_ASSERT_EQUAL_INT(0, sampler.start());
+        while (sampler.getStats().samples < 3) {
+            bus.waitUs(sampler.process());
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(before, allocations);
+}
+
+#ifdef __MBED__
+void TestHeap_pins() {
+    int before = allocations;
+    {
+        SI7050 sensor(SI7050_SDA, SI7050_SCL);
+
+        TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature());
+    }
+    TEST_ASSERT_EQUAL_INT(before, allocations);
+}
+
+void TestHeap_i2c() {
+    I2C i2c(SI7050_SDA, SI7050_SCL);
+    int before = allocations;
+    {
+        SI7050 sensor(i2c);
+
+        TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature());
+    }
+    TEST_ASSERT_EQUAL_INT(before, allocations);
+}
+#endif
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 no heap sensor-0", TestHeap_sensor, greentea_failure_handler),
+Case("SI7050 no heap group and sampler-0", TestHeap_helpers, greentea_failure_handler),
+#ifdef __MBED__
+Case("SI7050 no heap pin constructor-0", TestHeap_pins, greentea_failure_handler),
+Case("SI7050 no heap I2C constructor-0", TestHeap_i2c, greentea_failure_handler),
+#endif
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,289 @@
+/*
+ * SI7050 Sensor library tests of the compact block log format.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <string.h>
+
+#include "SI7050Log.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define SAMPLES 64
+
+static const unsigned char serial[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+
+// a 14 bit raw value has the lower 2 (status) bits cleared
+static uint16_t rawAt(int i) {
+    return (uint16_t) ((0x6A00 + (i % 7) * 4 - (i % 3) * 40) & 0xFFFC);
+}
+
+static int decodeAll(const uint8_t *data, size_t len, uint32_t *timestamps, uint16_t *raws, int max) {
+    SI7050LogDecoder decoder(data, len);
+    int n = 0;
+    int r;
+
+    while ((r = decoder.nextBlock()) == SI70_LOG_OK) {
+        while (n < max && decoder.next(&timestamps[n], &raws[n])) {
+            n++;
+        }
+    }
+    return r == SI70_LOG_CORRUPT ? -1 : n;
+}
+
+void TestLog_roundTrip() {
+    uint8_t block[512];
+    uint32_t timestamps[SAMPLES];
+    uint16_t raws[SAMPLES];
+    SI7050LogEncoder encoder(block, sizeof(block), serial, 14);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        // periodic with some jitter
+        TEST_ASSERT_EQUAL_INT(0, encoder.add(1000 + i * 20000 + (i % 4) * 3, rawAt(i)));
+    }
+    size_t len = encoder.finish();
+    TEST_ASSERT_EQUAL(encoder.getLength(), len);
+    // the periodic series takes 2 Bytes per sample
+    TEST_ASSERT_TRUE(len <= SI70_LOG_HEADER_SIZE + SI70_LOG_CRC_SIZE + 2 * (SAMPLES - 1) + 8);
+
+    SI7050LogDecoder decoder(block, len);
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_OK, decoder.nextBlock());
+    TEST_ASSERT_EQUAL_INT(14, decoder.getResolution());
+    TEST_ASSERT_EQUAL_INT(SAMPLES, decoder.getCount());
+    TEST_ASSERT_EQUAL_UINT32(1000, decoder.getTimestampBase());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(serial, decoder.getSerial(), 8);
+    // zero copy: the serial points into the block
+    TEST_ASSERT_TRUE(decoder.getSerial() == &block[6]);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_TRUE(decoder.next(&timestamps[i], &raws[i]));
+        TEST_ASSERT_EQUAL_UINT32(1000 + i * 20000 + (i % 4) * 3, timestamps[i]);
+        TEST_ASSERT_EQUAL_UINT16(rawAt(i), raws[i]);
+    }
+    TEST_ASSERT_FALSE(decoder.next(&timestamps[0], &raws[0]));
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_INCOMPLETE, decoder.nextBlock());
+    TEST_ASSERT_EQUAL(len, decoder.getConsumed());
+}
+
+void TestLog_edges() {
+    uint8_t block[128];
+    uint32_t timestamps[4];
+    uint16_t raws[4];
+    SI7050LogEncoder encoder(block, sizeof(block), serial, 11);
+    // largest steps of the raw value and a wrap of the us timer
+    const uint32_t ts[4] = {0xFFFFFF00, 0x00000100, 0x80000000, 0x00000000};
+    const uint16_t raw[4] = {0x0000, 0xFFE0, 0x0000, 0x8000};
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(0, encoder.add(ts[i], raw[i] | 0x1F));
+    }
+    size_t len = encoder.finish();
+    // the bits below the resolution are dropped
+    TEST_ASSERT_EQUAL_INT(4, decodeAll(block, len, timestamps, raws, 4));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT32(ts[i], timestamps[i]);
+        TEST_ASSERT_EQUAL_UINT16(raw[i], raws[i]);
+    }
+}
+
+void TestLog_full() {
+    uint8_t block[SI70_LOG_HEADER_SIZE + SI70_LOG_CRC_SIZE + 10];
+    uint32_t timestamps[SAMPLES];
+    uint16_t raws[SAMPLES];
+    SI7050LogEncoder encoder(block, sizeof(block), serial, 14);
+
+    TEST_ASSERT_EQUAL_INT(0, encoder.finish());
+    int added = 0;
+    while (encoder.add(added * 1000, rawAt(added)) == 0) {
+        added++;
+    }
+    TEST_ASSERT_EQUAL_INT(added, encoder.getCount());
+    TEST_ASSERT_TRUE(encoder.getLength() <= sizeof(block));
+    TEST_ASSERT_EQUAL_INT(added, decodeAll(block, encoder.finish(), timestamps, raws, SAMPLES));
+
+    // the sample, which did not fit, starts the next block
+    encoder.reset();
+    TEST_ASSERT_EQUAL_INT(0, encoder.getCount());
+    TEST_ASSERT_EQUAL_INT(0, encoder.add(added * 1000, rawAt(added)));
+    TEST_ASSERT_EQUAL_INT(1, encoder.getCount());
+}
+
+void TestLog_corrupt() {
+    uint8_t block[256];
+    uint32_t timestamps[SAMPLES];
+    uint16_t raws[SAMPLES];
+    SI7050LogEncoder encoder(block, sizeof(block), serial, 13);
+
+    for (int i = 0; i < 16; i++) {
+        encoder.add(i * 5000, rawAt(i));
+    }
+    size_t len = encoder.finish();
+    TEST_ASSERT_EQUAL_INT(16, decodeAll(block, len, timestamps, raws, SAMPLES));
+
+    // a flipped bit is never accepted: the CRC fails, or a broken length
+    // of the payload leaves the block incomplete
+    for (size_t i = 0; i < len; i++) {
+        block[i] ^= 0x10;
+        SI7050LogDecoder decoder(block, len);
+        TEST_ASSERT_NOT_EQUAL(SI70_LOG_OK, decoder.nextBlock());
+        block[i] ^= 0x10;
+    }
+    block[len - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-1, decodeAll(block, len, timestamps, raws, SAMPLES));
+    block[len - 1] ^= 0x01;
+
+    // a truncated block needs more data
+    SI7050LogDecoder decoder(block, len - 1);
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_INCOMPLETE, decoder.nextBlock());
+    decoder.setLength(len);
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_OK, decoder.nextBlock());
+}
+
+void TestLog_resync() {
+    uint8_t stream[512];
+    uint32_t timestamps[SAMPLES];
+    uint16_t raws[SAMPLES];
+    size_t starts[4];
+    size_t len = 0;
+
+    // 3 blocks of 16 samples, every Byte of the second block is broken once
+    for (int b = 0; b < 3; b++) {
+        SI7050LogEncoder encoder(&stream[len], sizeof(stream) - len, serial, 14);
+        for (int i = b * 16; i < b * 16 + 16; i++) {
+            encoder.add(i * 1000, rawAt(i));
+        }
+        starts[b] = len;
+        len += encoder.finish();
+    }
+    starts[3] = len;
+
+    for (size_t i = starts[1]; i < starts[2]; i++) {
+        SI7050LogDecoder decoder(stream, len);
+        int n = 0, blocks = 0, corrupt = 0;
+        int ret;
+
+        stream[i] ^= 0x10;
+        while ((ret = decoder.nextBlock()) != SI70_LOG_INCOMPLETE) {
+            if (ret == SI70_LOG_CORRUPT) {
+                corrupt++;
+                continue;
+            }
+            while (decoder.next(&timestamps[n], &raws[n])) {
+                n++;
+            }
+            blocks++;
+        }
+        stream[i] ^= 0x10;
+
+        // the first and the third block are decoded, the second one is skipped
+        TEST_ASSERT_EQUAL_INT(2, blocks);
+        TEST_ASSERT_TRUE(corrupt >= 1);
+        TEST_ASSERT_EQUAL_INT(32, n);
+        for (int k = 0; k < 32; k++) {
+            int sample = k < 16 ? k : k + 16;
+            TEST_ASSERT_EQUAL_UINT32(sample * 1000, timestamps[k]);
+            TEST_ASSERT_EQUAL_UINT16(rawAt(sample), raws[k]);
+        }
+        TEST_ASSERT_EQUAL(starts[2] - starts[1], decoder.getSkipped());
+        TEST_ASSERT_EQUAL(len, decoder.getConsumed());
+    }
+
+    // garbage in front of the stream is skipped
+    memmove(&stream[3], stream, len);
+    stream[0] = SI70_LOG_MAGIC;
+    stream[1] = 0x00;
+    stream[2] = SI70_LOG_MAGIC;
+    TEST_ASSERT_EQUAL_INT(-1, decodeAll(stream, len + 3, timestamps, raws, SAMPLES));
+    SI7050LogDecoder decoder(stream, len + 3);
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_CORRUPT, decoder.nextBlock());
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_CORRUPT, decoder.nextBlock());
+    TEST_ASSERT_EQUAL_INT(SI70_LOG_OK, decoder.nextBlock());
+    TEST_ASSERT_EQUAL(3, decoder.getSkipped());
+}
+
+void TestLog_stream() {
+    uint8_t stream[1024];
+    uint32_t timestamps[SAMPLES];
+    uint16_t raws[SAMPLES];
+    size_t len = 0;
+
+    // blocks of 8 samples of two sensors, decoded while the stream grows
+    const unsigned char other[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int b = 0; b < SAMPLES / 8; b++) {
+        SI7050LogEncoder encoder(&stream[len], sizeof(stream) - len, b & 1 ? other : serial, 12);
+        for (int i = b * 8; i < b * 8 + 8; i++) {
+            encoder.add(i * 1000, (uint16_t) (rawAt(i) & 0xFFF0));
+        }
+        len += encoder.finish();
+    }
+
+    SI7050LogDecoder decoder(stream, 0);
+    int n = 0, blocks = 0;
+    for (size_t available = 0; available <= len; available += 7) {
+        decoder.setLength(available);
+        while (decoder.nextBlock() == SI70_LOG_OK) {
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(blocks & 1 ? other : serial, decoder.getSerial(), 8);
+            while (decoder.next(&timestamps[n], &raws[n])) {
+                TEST_ASSERT_EQUAL_UINT32(n * 1000, timestamps[n]);
+                TEST_ASSERT_EQUAL_UINT16(rawAt(n) & 0xFFF0, raws[n]);
+                n++;
+            }
+            blocks++;
+        }
+    }
+    decoder.setLength(len);
+    while (decoder.nextBlock() == SI70_LOG_OK) {
+        while (decoder.next(&timestamps[n], &raws[n])) {
+            n++;
+        }
+        blocks++;
+    }
+    TEST_ASSERT_EQUAL_INT(SAMPLES / 8, blocks);
+    TEST_ASSERT_EQUAL_INT(SAMPLES, n);
+    TEST_ASSERT_EQUAL(len, decoder.getConsumed());
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 log round trip-0", TestLog_roundTrip, greentea_failure_handler),
+Case("SI7050 log edge values-0", TestLog_edges, greentea_failure_handler),
+Case("SI7050 log full block-0", TestLog_full, greentea_failure_handler),
+Case("SI7050 log corruption-0", TestLog_corrupt, greentea_failure_handler),
+Case("SI7050 log resynchronization-0", TestLog_resync, greentea_failure_handler),
+Case("SI7050 log stream-0", TestLog_stream, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,146 @@
+/*
+ * SI7050 Sensor library tests of the synchronized measurement on several
+ * simulated buses, which run on real threads.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050MultiBus.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define BUSES   3
+#define FRAMES  50
+
+// the starts of all sensors are within one conversion time, one sensor
+// after the other would take at least one conversion time per sensor
+#define MAX_SKEW_US SI70_CONV_TIME_14BIT_US
+
+void TestMultiBus_frames() {
+    SimI2CBus buses[BUSES];
+    SimSi7050 devices[BUSES];
+    SimSi7050 second((char) 0x82);
+    SI7050 *sensors[BUSES + 1];
+    SI7050MultiBus multi;
+    SI7050Frame frame;
+
+    for (int b = 0; b < BUSES; b++) {
+        buses[b].attach(devices[b]);
+        devices[b].setTemperature(2000 + b * 100);
+        sensors[b] = new SI7050(buses[b]);
+        TEST_ASSERT_EQUAL_INT(b, multi.add(*sensors[b]));
+    }
+    // a second sensor on the first bus shares its worker
+    buses[0].attach(second);
+    second.setTemperature(1500);
+    sensors[BUSES] = new SI7050(buses[0], (char) 0x82);
+    TEST_ASSERT_EQUAL_INT(BUSES, multi.add(*sensors[BUSES]));
+    TEST_ASSERT_EQUAL_INT(BUSES, multi.getBuses());
+
+    TEST_ASSERT_EQUAL_INT(-1, multi.capture(&frame));
+    TEST_ASSERT_EQUAL_INT(0, multi.start());
+    TEST_ASSERT_EQUAL_INT(-1, multi.add(*sensors[0]));
+
+    for (int f = 0; f < FRAMES; f++) {
+        TEST_ASSERT_EQUAL_INT(0, multi.capture(&frame));
+        TEST_ASSERT_EQUAL_INT(BUSES + 1, frame.count);
+        for (int i = 0; i < BUSES; i++) {
+            TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_OK, frame.samples[i].status);
+            TEST_ASSERT_INT_WITHIN(2, 2000 + i * 100, Si705xCentiCelsius::fromRaw(frame.samples[i].raw));
+            TEST_ASSERT_TRUE((int32_t) (frame.samples[i].timestamp - frame.timestamp) >= 0);
+        }
+        TEST_ASSERT_INT_WITHIN(2, 1500, Si705xCentiCelsius::fromRaw(frame.samples[BUSES].raw));
+
+        // the skew is the spread of the conversion starts
+        uint32_t first = frame.samples[0].timestamp, last = first;
+        for (int i = 1; i <= BUSES; i++) {
+            if ((int32_t) (frame.samples[i].timestamp - first) < 0) {
+                first = frame.samples[i].timestamp;
+            }
+            if ((int32_t) (frame.samples[i].timestamp - last) > 0) {
+                last = frame.samples[i].timestamp;
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(last - first, frame.skewUs);
+        TEST_ASSERT_TRUE(frame.skewUs <= multi.getMaxSkew());
+    }
+    multi.stop();
+
+    TEST_ASSERT_EQUAL_UINT32(FRAMES, multi.getFrames());
+    for (int b = 0; b < BUSES; b++) {
+        TEST_ASSERT_EQUAL_UINT32(FRAMES, devices[b].getConversions());
+    }
+    TEST_ASSERT_EQUAL_UINT32(FRAMES, second.getConversions());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_SKEW_US, multi.getMaxSkew());
+
+    for (int i = 0; i <= BUSES; i++) {
+        delete sensors[i];
+    }
+}
+
+void TestMultiBus_errors() {
+    SimI2CBus buses[2];
+    SimSi7050 devices[2];
+    SI7050 sensor0(buses[0]), sensor1(buses[1]);
+    SI7050MultiBus multi;
+    SI7050Frame frame;
+
+    TEST_ASSERT_EQUAL_INT(-1, multi.start());
+    buses[0].attach(devices[0]);
+    buses[1].attach(devices[1]);
+    multi.add(sensor0);
+    multi.add(sensor1);
+    TEST_ASSERT_EQUAL_INT(0, multi.start());
+
+    // a failing bus does not block the other one
+    buses[1].failNext(1);
+    TEST_ASSERT_EQUAL_INT(1, multi.capture(&frame));
+    TEST_ASSERT_EQUAL_INT(1, frame.errors);
+    TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_OK, frame.samples[0].status);
+    TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_ERROR, frame.samples[1].status);
+    TEST_ASSERT_EQUAL_UINT32(0, frame.skewUs);
+
+    TEST_ASSERT_EQUAL_INT(0, multi.capture(&frame));
+    // stopped by the destructor
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 multi bus frames-0", TestMultiBus_frames, greentea_failure_handler),
+Case("SI7050 multi bus errors-0", TestMultiBus_errors, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,239 @@
+/*
+ * SI7050 Sensor library tests of the retry and recovery policy with
+ * fault injection on the simulated bus.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+static const SI7050RetryPolicy policy = {
+        5,          // retries
+        1000,       // backoff
+        8000,       // max backoff
+        true,       // bus recovery
+        true,       // soft reset
+        0           // no deadline
+};
+
+void TestRecovery_default() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    bus.attach(device);
+
+    // without policy, a fault fails the call at once
+    bus.setStuck(true);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT32(0, sensor.getRecoveryStats().retries);
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.getRecoveryStats().failures);
+}
+
+void TestRecovery_retry() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    sensor.setRetryPolicy(policy);
+    device.setTemperature(2247);
+    bus.failNext(1);
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+
+    const SI7050RecoveryStats &stats = sensor.getRecoveryStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.retries);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.recovered);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.busRecoveries);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.failures);
+}
+
+void TestRecovery_stuckBus() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    // SDA held low by a slave, until the bus is clocked out
+    sensor.setRetryPolicy(policy);
+    device.setTemperature(2247);
+    bus.setStuck(true);
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+
+    const SI7050RecoveryStats &stats = sensor.getRecoveryStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.retries);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.busRecoveries);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.softResets);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.recovered);
+}
+
+void TestRecovery_softReset() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    sensor.setRetryPolicy(policy);
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(12));
+
+    // the sensor does not answer the first three attempts
+    device.setTemperature(2247);
+    device.failNext(3);
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_INT_WITHIN(4, 2247, sensor.getTemperature());
+    TEST_ASSERT_TRUE_MESSAGE(bus.readUs() - start >= SI70_RESET_TIME_US, "no wait after the reset");
+
+    const SI7050RecoveryStats &stats = sensor.getRecoveryStats();
+    TEST_ASSERT_EQUAL_UINT32(3, stats.retries);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.busRecoveries);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.softResets);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.recovered);
+
+    // the configuration is written again after the reset
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(SI70_RES_12BIT, device.getUserRegister() & SI70_RES_MASK,
+                                   "resolution lost by the reset");
+    TEST_ASSERT_EQUAL_INT(12, sensor.getResolution());
+}
+
+void TestRecovery_deadline() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    SI7050RetryPolicy limited = policy;
+    char data[2];
+    bus.attach(device);
+
+    // a permanent fault: the retries stop at the deadline
+    limited.retries = 100;
+    limited.deadlineUs = 30000;
+    sensor.setRetryPolicy(limited);
+    bus.setStuck(true, false);
+
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    TEST_ASSERT_TRUE_MESSAGE(bus.readUs() - start <= limited.deadlineUs, "deadline exceeded");
+
+    const SI7050RecoveryStats &stats = sensor.getRecoveryStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.deadlines);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failures);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.recovered);
+    TEST_ASSERT_TRUE(stats.retries < 10);
+
+    // the bus stays stuck after all retries
+    TEST_ASSERT_EQUAL_INT(-1, sensor.initialize());
+    TEST_ASSERT_EQUAL_UINT32(2, stats.failures);
+}
+
+void TestRecovery_slowAttempt() {
+    SI7050RetryPolicy limited = policy;
+    char data[2];
+
+    limited.retries = 100;
+    limited.busRecovery = false;
+    limited.softReset = false;
+
+    for (uint32_t deadline = 25000; deadline <= 80000; deadline += 500) {
+        SimI2CBus bus;
+        SimSi7050 device;
+        SI7050 sensor(bus);
+        bus.attach(device);
+
+        // an attempt waits twice the conversion time, the sensor needs longer
+        device.setConversionTime(14, 25000);
+        limited.deadlineUs = deadline;
+        sensor.setRetryPolicy(limited);
+
+        uint32_t start = bus.readUs();
+        TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+        TEST_ASSERT_TRUE_MESSAGE(bus.readUs() - start <= deadline, "last attempt ended after the deadline");
+        TEST_ASSERT_EQUAL_UINT32(1, sensor.getRecoveryStats().deadlines);
+    }
+}
+
+void TestRecovery_uncappedBackoff() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    SI7050RetryPolicy uncapped = policy;
+    char data[2];
+    bus.attach(device);
+
+    // no upper limit: the backoff doubles for every retry, 1 + 2 + 4 ms
+    uncapped.retries = 3;
+    uncapped.maxBackoffUs = 0;
+    uncapped.busRecovery = false;
+    uncapped.softReset = false;
+    sensor.setRetryPolicy(uncapped);
+    bus.setStuck(true, false);
+
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    TEST_ASSERT_TRUE_MESSAGE(bus.readUs() - start >= 7000, "backoff not doubled");
+    TEST_ASSERT_EQUAL_UINT32(3, sensor.getRecoveryStats().retries);
+}
+
+void TestRecovery_crc() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    bus.attach(device);
+
+    // CRC errors are handled by the integrity mode, not by the policy
+    sensor.setRetryPolicy(policy);
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    TEST_ASSERT_EQUAL_INT(SI70_ERROR_CRC, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(0, sensor.getRecoveryStats().retries);
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 recovery default policy-0", TestRecovery_default, greentea_failure_handler),
+Case("SI7050 recovery retry-0", TestRecovery_retry, greentea_failure_handler),
+Case("SI7050 recovery stuck bus-0", TestRecovery_stuckBus, greentea_failure_handler),
+Case("SI7050 recovery soft reset-0", TestRecovery_softReset, greentea_failure_handler),
+Case("SI7050 recovery deadline-0", TestRecovery_deadline, greentea_failure_handler),
+Case("SI7050 recovery slow attempt-0", TestRecovery_slowAttempt, greentea_failure_handler),
+Case("SI7050 recovery uncapped backoff-0", TestRecovery_uncappedBackoff, greentea_failure_handler),
+Case("SI7050 recovery CRC errors-0", TestRecovery_crc, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
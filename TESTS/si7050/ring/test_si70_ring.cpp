@@ -0,0 +1,157 @@
+/*
+ * SI7050 sample ring buffer tests.
+ *
+ * These tests do not need the real sensor and also run on the host,
+ * see host/CMakeLists.txt.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050SampleRing.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+static SI7050Sample makeSample(uint32_t i) {
+    SI7050Sample sample;
+    sample.timestamp = i * 1000;
+    sample.raw = (uint16_t) (0x6000 + i);
+    sample.status = SI70_SAMPLE_OK;
+    return sample;
+}
+
+void TestRing_pushPop() {
+    SI7050SampleRing<4> ring;
+    SI7050Sample sample;
+
+    TEST_ASSERT_EQUAL_INT(4, ring.capacity());
+    TEST_ASSERT_FALSE_MESSAGE(ring.pop(sample), "pop from empty ring");
+
+    // several rounds, so the indices wrap around the buffer
+    for (uint32_t round = 0; round < 5; round++) {
+        for (uint32_t i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE_MESSAGE(ring.push(makeSample(round * 3 + i)), "push failed");
+        }
+        TEST_ASSERT_EQUAL_INT(3, ring.size());
+        for (uint32_t i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE_MESSAGE(ring.pop(sample), "pop failed");
+            TEST_ASSERT_EQUAL_UINT32(makeSample(round * 3 + i).raw, sample.raw);
+            TEST_ASSERT_EQUAL_UINT32(makeSample(round * 3 + i).timestamp, sample.timestamp);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, ring.size());
+}
+
+void TestRing_overrun() {
+    SI7050SampleRing<4> ring;
+    SI7050Sample sample;
+
+    for (uint32_t i = 0; i < 6; i++) {
+        ring.push(makeSample(i));
+    }
+    TEST_ASSERT_EQUAL_INT(4, ring.size());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, ring.getOverruns(), "overruns not counted");
+
+    // the oldest samples are kept
+    TEST_ASSERT_TRUE(ring.pop(sample));
+    TEST_ASSERT_EQUAL_UINT32(makeSample(0).raw, sample.raw);
+}
+
+void TestRing_spans() {
+    SI7050SampleRing<8> ring;
+    SI7050SampleSpan spans[2];
+    SI7050Sample sample;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ring.peek(spans), "spans of an empty ring");
+
+    for (uint32_t i = 0; i < 6; i++) {
+        ring.push(makeSample(i));
+    }
+    TEST_ASSERT_EQUAL_INT(1, ring.peek(spans));
+    TEST_ASSERT_EQUAL_INT(6, spans[0].length);
+    ring.consume(5);
+
+    // 1 old sample at the end, 5 new samples wrap around
+    for (uint32_t i = 6; i < 11; i++) {
+        ring.push(makeSample(i));
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, ring.peek(spans), "wrapped samples not in two spans");
+    TEST_ASSERT_EQUAL_INT(3, spans[0].length);
+    TEST_ASSERT_EQUAL_INT(3, spans[1].length);
+    uint32_t expect = 5;
+    for (int s = 0; s < 2; s++) {
+        for (size_t i = 0; i < spans[s].length; i++) {
+            TEST_ASSERT_EQUAL_UINT32(makeSample(expect++).raw, spans[s].data[i].raw);
+        }
+    }
+
+    ring.consume(4);
+    TEST_ASSERT_TRUE(ring.pop(sample));
+    TEST_ASSERT_EQUAL_UINT32(makeSample(9).raw, sample.raw);
+    ring.consume(100);
+    TEST_ASSERT_EQUAL_INT(0, ring.size());
+}
+
+void TestRing_measureSample() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    SI7050SampleRing<4> ring;
+    SI7050Sample sample;
+    bus.attach(device);
+
+    device.setRawTemperature(0x6544);
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureSample(&sample));
+    TEST_ASSERT_EQUAL_UINT32(0x6544, sample.raw);
+    TEST_ASSERT_EQUAL_UINT32(bus.readUs(), sample.timestamp);
+    TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_OK, sample.status);
+    TEST_ASSERT_TRUE(ring.push(sample));
+
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureSample(&sample));
+    TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_ERROR, sample.status);
+    TEST_ASSERT_TRUE(ring.push(sample));
+    TEST_ASSERT_EQUAL_INT(2, ring.size());
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 ring push and pop-0", TestRing_pushPop, greentea_failure_handler),
+Case("SI7050 ring overrun-0", TestRing_overrun, greentea_failure_handler),
+Case("SI7050 ring contiguous spans-0", TestRing_spans, greentea_failure_handler),
+Case("SI7050 ring measure sample-0", TestRing_measureSample, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,244 @@
+/*
+ * SI7050 Sensor library tests of the periodic sampler against the
+ * simulated sensor.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Sampler.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define SAMPLES 20
+
+struct Collector {
+    SimI2CBus *bus;
+    uint32_t timestamps[SAMPLES];
+    int count;
+    int errors;
+    uint32_t busyUs;    // work of the application in the callback
+};
+
+static void collect(void *context, const SI7050Sample *sample) {
+    Collector *collector = (Collector *) context;
+
+    if (collector->count < SAMPLES) {
+        collector->timestamps[collector->count] = sample->timestamp;
+    }
+    collector->count++;
+    if (sample->status != SI70_SAMPLE_OK) {
+        collector->errors++;
+    }
+    collector->bus->waitUs(collector->busyUs);
+}
+
+/*
+ * Drive the sampler like the event queue: sleep until process() is due.
+ */
+static void runSampler(SI7050Sampler &sampler, SimI2CBus &bus, Collector &collector, int samples) {
+    while (collector.count < samples) {
+        bus.waitUs(sampler.process());
+    }
+}
+
+void TestSampler_deadlines() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, 100000, collect, &collector);
+    bus.attach(device);
+
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    runSampler(sampler, bus, collector, SAMPLES);
+
+    // no drift: the samples are on the grid of the period
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_EQUAL_UINT32(start + i * 100000u, collector.timestamps[i]);
+    }
+    const SI7050SamplerStats &stats = sampler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.errors);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.maxJitterUs);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, device.getConversions());
+}
+
+void TestSampler_missed() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, 20000, collect, &collector);
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    runSampler(sampler, bus, collector, 2);
+
+    // the application blocks for 2.5 periods, two deadlines are missed
+    collector.busyUs = 50000;
+    runSampler(sampler, bus, collector, 3);
+    collector.busyUs = 0;
+    runSampler(sampler, bus, collector, 6);
+
+    const SI7050SamplerStats &stats = sampler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.missed);
+    TEST_ASSERT_TRUE(stats.maxJitterUs > 0 && stats.maxJitterUs < 20000);
+    TEST_ASSERT_EQUAL_UINT32(collector.timestamps[2] + 3 * 20000, collector.timestamps[3]);
+    TEST_ASSERT_EQUAL_UINT32(collector.timestamps[4] + 20000, collector.timestamps[5]);
+}
+
+void TestSampler_rate() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, SI70_CONV_TIME_14BIT_US, collect, &collector);
+    bus.attach(device);
+
+    // the period is limited by the conversion time of the resolution
+    TEST_ASSERT_EQUAL_INT(-1, sampler.start());
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(11));
+    TEST_ASSERT_EQUAL_UINT32(SI70_CONV_TIME_11BIT_US + SI70_SAMPLER_MARGIN_US, sampler.getMinPeriod());
+    TEST_ASSERT_EQUAL_INT(0, sampler.setPeriod(sampler.getMinPeriod()));
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    runSampler(sampler, bus, collector, SAMPLES);
+
+    const SI7050SamplerStats &stats = sampler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.errors);
+    TEST_ASSERT_EQUAL_UINT32(collector.timestamps[0] + (SAMPLES - 1) * sampler.getPeriod(),
+                             collector.timestamps[SAMPLES - 1]);
+
+    sampler.stop();
+    TEST_ASSERT_FALSE(sampler.isRunning());
+    TEST_ASSERT_FALSE(sensor.isMeasuring());
+}
+
+void TestSampler_errors() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, 20000, collect, &collector);
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    bus.failNext(1);
+    runSampler(sampler, bus, collector, 3);
+
+    TEST_ASSERT_EQUAL_INT(1, collector.errors);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.getStats().errors);
+    TEST_ASSERT_EQUAL_UINT32(collector.timestamps[0] + 20000, collector.timestamps[1]);
+}
+void TestSampler_adaptive() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, 20000, collect, &collector);
+    SI7050AdaptivePolicy policy = {20, 2, 160000, 11};
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sampler.setAdaptivePolicy(policy));
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    TEST_ASSERT_EQUAL_INT(-1, sampler.setAdaptivePolicy(policy));
+
+    // a flat temperature: the interval doubles every 2 samples, up to the maximum
+    runSampler(sampler, bus, collector, 10);
+    TEST_ASSERT_EQUAL_UINT32(160000, sampler.getInterval());
+    TEST_ASSERT_EQUAL_INT(11, sensor.getResolution());
+    TEST_ASSERT_EQUAL_UINT32(20000, collector.timestamps[1] - collector.timestamps[0]);
+    TEST_ASSERT_EQUAL_UINT32(20000, collector.timestamps[2] - collector.timestamps[1]);
+    TEST_ASSERT_EQUAL_UINT32(40000, collector.timestamps[3] - collector.timestamps[2]);
+    TEST_ASSERT_EQUAL_UINT32(160000, collector.timestamps[9] - collector.timestamps[8]);
+
+    // 10 samples instead of the 40 at the fixed period
+    const SI7050SamplerStats &stats = sampler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(10, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32((collector.timestamps[9] - collector.timestamps[0]) / 20000 + 1, stats.baseline);
+    TEST_ASSERT_EQUAL_UINT32(10, device.getConversions());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.resolutionChanges);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+
+    // a step: back to the period and the resolution at once
+    device.setTemperature(2600);
+    runSampler(sampler, bus, collector, 12);
+    TEST_ASSERT_EQUAL_UINT32(20000, sampler.getInterval());
+    TEST_ASSERT_EQUAL_INT(14, sensor.getResolution());
+    TEST_ASSERT_EQUAL_UINT32(2, stats.resolutionChanges);
+    TEST_ASSERT_EQUAL_UINT32(20000, collector.timestamps[11] - collector.timestamps[10]);
+    sampler.stop();
+
+    // the policy is checked
+    SI7050AdaptivePolicy invalid = {20, 0, 160000, 0};
+    TEST_ASSERT_EQUAL_INT(-1, sampler.setAdaptivePolicy(invalid));
+    invalid.stableSamples = 2;
+    invalid.coarseBits = 10;
+    TEST_ASSERT_EQUAL_INT(-1, sampler.setAdaptivePolicy(invalid));
+    invalid.bandCentiCelsius = -1;
+    invalid.maxPeriodUs = 0;
+    TEST_ASSERT_EQUAL_INT(0, sampler.setAdaptivePolicy(invalid));
+}
+
+void TestSampler_adaptiveDisabled() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    Collector collector = {&bus, {}, 0, 0, 0};
+    SI7050Sampler sampler(sensor, 20000, collect, &collector);
+    bus.attach(device);
+
+    // the default policy samples at the fixed period, the baseline matches
+    TEST_ASSERT_EQUAL_INT(0, sampler.start());
+    runSampler(sampler, bus, collector, SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(20000, sampler.getInterval());
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, sampler.getStats().baseline);
+    TEST_ASSERT_EQUAL_UINT32(0, sampler.getStats().resolutionChanges);
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 sampler deadlines-0", TestSampler_deadlines, greentea_failure_handler),
+Case("SI7050 sampler missed deadlines-0", TestSampler_missed, greentea_failure_handler),
+Case("SI7050 sampler maximum rate-0", TestSampler_rate, greentea_failure_handler),
+Case("SI7050 sampler errors-0", TestSampler_errors, greentea_failure_handler),
+Case("SI7050 sampler adaptive-0", TestSampler_adaptive, greentea_failure_handler),
+Case("SI7050 sampler adaptive disabled-0", TestSampler_adaptiveDisabled, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
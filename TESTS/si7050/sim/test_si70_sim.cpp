@@ -0,0 +1,355 @@
+/*
+ * SI7050 Sensor library tests against the simulated sensor.
+ *
+ * These tests do not need the real sensor and also run on the host,
+ * see host/CMakeLists.txt.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+class testSi7050 : public SI7050 {
+public:
+    explicit testSi7050(SI7050Bus &bus_obj) : SI7050(bus_obj) {}
+
+    bool checkSerial(unsigned char *serialRaw) {
+        return SI7050::checkSerial(serialRaw);
+    }
+};
+
+void TestSim_resetInitialize() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    device.setConversionTime(14, 100);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.reset(), "failed to reset the sensor");
+    TEST_ASSERT_UNLESS_MESSAGE(sensor.initialize() == 0, "sensor answered during the reset time");
+
+    bus.waitUs(SIM_SI70_RESET_TIME_US);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(SIM_SI70_UR_DEFAULT & ~SI70_RES_MASK, device.getUserRegister(),
+                                   "user register not set to 14 bit");
+}
+
+void TestSim_getTemperature() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    device.setTemperature(2247);
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    device.setTemperature(-4000);
+    TEST_ASSERT_INT_WITHIN(1, -4000, sensor.getTemperature());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, device.getConversions(), "wrong number of conversions");
+}
+
+void TestSim_resolution() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    const int bits[] = {11, 12, 13, 14};
+    bus.attach(device);
+
+    device.setRawTemperature(0x64FF);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.setResolution(bits[i]), "failed to set the resolution");
+        uint32_t start = bus.readUs();
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.measureTemperature(data), "failed to measure");
+        uint32_t duration = bus.readUs() - start;
+        TEST_ASSERT_MESSAGE(duration >= sensor.getConversionTime(), "waited less than the conversion time");
+        TEST_ASSERT_MESSAGE(duration < sensor.getConversionTime() + 1000, "waited too long");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, (unsigned char) data[1] & ((1 << (16 - bits[i])) - 1),
+                                      "sensor delivered bits below the resolution");
+    }
+}
+
+void TestSim_splitPhase() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    int ret;
+    bus.attach(device);
+
+    device.setConversionTime(14, 5000);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.startMeasurement(), "failed to start the measurement");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(SI70_NOT_READY, sensor.pollResult(data), "result ready too early");
+    bus.waitUs(5000);
+    ret = sensor.pollResult(data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "result not ready after the conversion time");
+
+    // the sensor does not answer at all: timeout after twice the conversion time
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.startMeasurement(), "failed to start the measurement");
+    bus.setStuck(true);
+    do {
+        bus.waitUs(1000);
+        ret = sensor.pollResult(data);
+    } while (ret == SI70_NOT_READY);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, ret, "no timeout on a stuck bus");
+    TEST_ASSERT_FALSE_MESSAGE(sensor.isMeasuring(), "measurement still pending after timeout");
+}
+
+void TestSim_faults() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-32768, sensor.getTemperature(), "bus error not reported");
+    device.failNext(1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, sensor.getFirmwareVersion(), "sensor NACK not reported");
+    TEST_ASSERT_INT_WITHIN(1, 2500, sensor.getTemperature());
+}
+
+void TestSim_integrityMode() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    // without the check, corrupted data reaches the application
+    device.setTemperature(2000);
+    device.corruptNext(1);
+    TEST_ASSERT_UNLESS_MESSAGE(sensor.getTemperature() == 2000, "corrupted data not detected by the test");
+
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    TEST_ASSERT_EQUAL_INT(SI70_INTEGRITY_CRC, sensor.getIntegrityMode());
+    device.corruptNext(SI70_CRC_RETRIES);
+    TEST_ASSERT_INT_WITHIN(1, 2000, sensor.getTemperature());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2 + SI70_CRC_RETRIES, device.getConversions(), "wrong number of retries");
+
+    char data[2];
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(SI70_ERROR_CRC, sensor.measureTemperature(data), "CRC error not reported");
+    TEST_ASSERT_INT_WITHIN(1, 2000, sensor.getTemperature());
+}
+
+void TestSim_completionMode() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    uint32_t start, sleepTime, pollTime, holdTime;
+    bus.attach(device);
+
+    device.setTemperature(2247);
+    device.setConversionTime(14, 5000);
+    TEST_ASSERT_EQUAL_INT(SI70_COMPLETION_SLEEP, sensor.getCompletionMode());
+    TEST_ASSERT_EQUAL_INT(-1, sensor.setCompletionMode(3));
+
+    start = bus.readUs();
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    sleepTime = bus.readUs() - start;
+    TEST_ASSERT_TRUE_MESSAGE(sleepTime >= SI70_CONV_TIME_14BIT_US, "sleep mode did not wait the maximum time");
+
+    // poll until the sensor acknowledges
+    TEST_ASSERT_EQUAL_INT(0, sensor.setCompletionMode(SI70_COMPLETION_POLL, 250));
+    start = bus.readUs();
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    pollTime = bus.readUs() - start;
+    TEST_ASSERT_TRUE_MESSAGE(pollTime >= 5000 && pollTime < 5000 + 250 + 1000, "poll mode not finished after ready");
+
+    // the sensor stretches the clock, one write and one read
+    TEST_ASSERT_EQUAL_INT(0, sensor.setCompletionMode(SI70_COMPLETION_HOLD));
+    uint32_t transfers = bus.getTransfers();
+    start = bus.readUs();
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    holdTime = bus.readUs() - start;
+    TEST_ASSERT_EQUAL_UINT32(2, bus.getTransfers() - transfers);
+    TEST_ASSERT_TRUE_MESSAGE(holdTime >= 5000 && holdTime < 6000, "hold mode not finished after ready");
+
+    // CRC retries in hold master mode
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    device.corruptNext(SI70_CRC_RETRIES);
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    char data[2];
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    TEST_ASSERT_EQUAL_INT(SI70_ERROR_CRC, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(3 + 2 * SI70_CRC_RETRIES + 2, device.getConversions());
+
+    // poll mode gives up after twice the conversion time
+    sensor.setIntegrityMode(SI70_INTEGRITY_NONE);
+    TEST_ASSERT_EQUAL_INT(0, sensor.setCompletionMode(SI70_COMPLETION_POLL));
+    device.setConversionTime(14, 3 * SI70_CONV_TIME_14BIT_US);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+}
+
+void TestSim_identification() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    unsigned char serial[8];
+    const unsigned char expect[8] = {0x00, 0x16, 0x4b, 0xe6, 0x32, 0xff, 0xff, 0xff};
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(SIM_SI70_FW_VERSION, sensor.getFirmwareVersion(), "wrong firmware version");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(0x32, sensor.getID(), "wrong sensor detected");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.getSerial(serial), "failed to read the serial");
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(expect, serial, 8, "wrong serial");
+
+    // the ID is checked with its CRC
+    device.corruptNext(1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, sensor.getSerial(serial), "corrupted serial not detected");
+}
+
+void TestSim_descriptor() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    unsigned char serial[8];
+    const unsigned char other[8] = {0x01, 0x02, 0x03, 0x04, 0x33, 0x05, 0x06, 0x07};
+    bus.attach(device);
+
+    TEST_ASSERT_FALSE_MESSAGE(sensor.getDescriptor().valid, "descriptor valid before initialize");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor");
+    TEST_ASSERT_TRUE_MESSAGE(sensor.getDescriptor().valid, "descriptor not read by initialize");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(device.getUserRegister(), sensor.getDescriptor().userRegister,
+                                   "wrong user register in the descriptor");
+
+    // the identity is served from RAM
+    uint32_t transfers = bus.getTransfers();
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(0x32, sensor.getID(), "wrong sensor detected");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(SIM_SI70_FW_VERSION, sensor.getFirmwareVersion(), "wrong firmware version");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.getSerial(serial), "failed to get the serial");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers, bus.getTransfers(), "identity read from the bus");
+
+    // a second initialize does not read the identity again
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor again");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers, bus.getTransfers(), "identity read again by initialize");
+
+    device.setSerial(other);
+    device.setFirmwareVersion((char) 0xFF);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.refreshDescriptor(), "failed to refresh the descriptor");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(0x33, sensor.getID(), "ID not refreshed");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0xFF, sensor.getFirmwareVersion(), "firmware version not refreshed");
+
+    device.failNext(1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, sensor.refreshDescriptor(), "refresh error not reported");
+    TEST_ASSERT_FALSE_MESSAGE(sensor.getDescriptor().valid, "descriptor valid after error");
+}
+
+void TestSim_shadowRegister() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor");
+    uint32_t transfers = bus.getTransfers();
+    uint32_t skipped = sensor.getSkippedTransactions();
+
+    // unchanged configuration: no bus transfer at all
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor again");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.setResolution(14), "failed to set the same resolution");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers, bus.getTransfers(), "redundant user register access");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(skipped + 6, sensor.getSkippedTransactions(), "wrong number of skipped transfers");
+
+    // changed configuration: only the write
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.setResolution(12), "failed to set the resolution");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers + 1, bus.getTransfers(), "user register not written once");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(SI70_RES_12BIT, device.getUserRegister() & SI70_RES_MASK, "resolution not written");
+
+    // after reset the shadow is stale: read and write again
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.reset(), "failed to reset the sensor");
+    bus.waitUs(SIM_SI70_RESET_TIME_US);
+    transfers = bus.getTransfers();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize after reset");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers + 3, bus.getTransfers(), "user register not read after reset");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(SI70_RES_12BIT, device.getUserRegister() & SI70_RES_MASK,
+                                   "resolution not restored after reset");
+}
+
+void TestSim_checkSerialCRC() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    testSi7050 sensor(bus);
+    char cmd[2] = {(char) SI70_READ_ID_11, (char) SI70_READ_ID_12};
+    char data[16];
+    bus.attach(device);
+
+    // the simulated sensor generates the same ID as the real one
+    unsigned char testStr[16] = {0x00, 0x00, 0x16, 0xe5, 0x4b, 0xe3, 0xe6, 0xf5, 0x32, 0xff, 0xc7, 0xff, 0xff, 0x29, 0xff, 0xff};
+    bus.write(SI70_ADDRESS, cmd, 2, true);
+    bus.read(SI70_ADDRESS, data, 8, false);
+    cmd[0] = (char) SI70_READ_ID_21;
+    cmd[1] = (char) SI70_READ_ID_22;
+    bus.write(SI70_ADDRESS, cmd, 2, true);
+    bus.read(SI70_ADDRESS, &data[8], 8, false);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(testStr, data, 16, "simulated ID differs");
+    TEST_ASSERT_MESSAGE(sensor.checkSerial(testStr), "serial number CRC check failed");
+}
+
+// the CRC engine against the bit by bit definition for all Bytes and initializers
+void TestSim_crcEngine() {
+    for (int init = 0; init < 256; init++) {
+        for (int i = 0; i < 256; i++) {
+            unsigned char data = (unsigned char) i;
+            unsigned char crc = (unsigned char) (init ^ i);
+            for (int j = 0; j < 8; j++) {
+                crc = (unsigned char) ((crc & 0x80) ? (crc << 1) ^ SI70_CRC_POLYNOMIAL : (crc << 1));
+            }
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(crc, SI7050Crc::calcTable(&data, 1, (unsigned char) init),
+                                           "wrong table CRC");
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(crc, SI7050Crc::calcNibble(&data, 1, (unsigned char) init),
+                                           "wrong nibble CRC");
+        }
+    }
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 sim reset and initialize-0", TestSim_resetInitialize, greentea_failure_handler),
+Case("SI7050 sim get temperature-0", TestSim_getTemperature, greentea_failure_handler),
+Case("SI7050 sim resolution and conversion time-0", TestSim_resolution, greentea_failure_handler),
+Case("SI7050 sim split-phase measurement-0", TestSim_splitPhase, greentea_failure_handler),
+Case("SI7050 sim fault injection-0", TestSim_faults, greentea_failure_handler),
+Case("SI7050 sim integrity mode-0", TestSim_integrityMode, greentea_failure_handler),
+Case("SI7050 sim completion mode-0", TestSim_completionMode, greentea_failure_handler),
+Case("SI7050 sim identification-0", TestSim_identification, greentea_failure_handler),
+Case("SI7050 sim descriptor-0", TestSim_descriptor, greentea_failure_handler),
+Case("SI7050 sim shadow user register-0", TestSim_shadowRegister, greentea_failure_handler),
+Case("SI7050 sim serial CRC-0", TestSim_checkSerialCRC, greentea_failure_handler),
+Case("SI7050 sim CRC engine-0", TestSim_crcEngine, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,193 @@
+/*
+ * SI7050 Sensor library tests of the instrumentation against the
+ * simulated sensor. The library has to be built with SI70_STATS
+ * (on the host: si7050-stats, on mbed: add it to the macros).
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+void TestStats_bucket() {
+    TEST_ASSERT_EQUAL_INT(0, SI7050Stats::bucket(0));
+    TEST_ASSERT_EQUAL_INT(0, SI7050Stats::bucket(1));
+    TEST_ASSERT_EQUAL_INT(1, SI7050Stats::bucket(2));
+    TEST_ASSERT_EQUAL_INT(1, SI7050Stats::bucket(3));
+    TEST_ASSERT_EQUAL_INT(13, SI7050Stats::bucket(SI70_CONV_TIME_14BIT_US));
+    TEST_ASSERT_EQUAL_INT(SI70_STATS_BUCKETS - 1, SI7050Stats::bucket(0xFFFFFFFF));
+}
+
+#ifdef SI70_STATS
+
+static uint32_t histogramSum(const SI7050OpStats &op) {
+    uint32_t sum = 0;
+
+    for (int i = 0; i < SI70_STATS_BUCKETS; i++) {
+        sum += op.histogram[i];
+    }
+    return sum;
+}
+
+void TestStats_operations() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sensor.reset());
+    bus.waitUs(SIM_SI70_RESET_TIME_US);
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_NOT_EQUAL(-32768, sensor.getTemperature());
+    }
+
+    const SI7050Stats &stats = sensor.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_RESET].calls);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.op[SI70_OP_RESET].bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_CONFIG].calls);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_IDENT].calls);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.op[SI70_OP_MEASURE].calls);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.op[SI70_OP_MEASURE].failures);
+
+    // measure command (2 Bytes) and the read of the result (3 Bytes)
+    TEST_ASSERT_EQUAL_UINT32(10 * 5, stats.op[SI70_OP_MEASURE].bytes);
+    TEST_ASSERT_EQUAL_UINT32(10, histogramSum(stats.op[SI70_OP_MEASURE]));
+    TEST_ASSERT_EQUAL_UINT32(10, stats.op[SI70_OP_MEASURE].histogram[13]);
+    TEST_ASSERT_TRUE(stats.op[SI70_OP_MEASURE].maxUs >= SI70_CONV_TIME_14BIT_US);
+
+    // served from the descriptor, not counted
+    sensor.getFirmwareVersion();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_IDENT].calls);
+
+    sensor.clearStats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.op[SI70_OP_MEASURE].calls);
+}
+
+void TestStats_errors() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    bus.attach(device);
+
+    const SI7050Stats &stats = sensor.getStats();
+
+    bus.failNext(1);
+    TEST_ASSERT_NOT_EQUAL(0, sensor.reset());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_RESET].failures);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_RESET].bytes);
+
+    // command of the user register read
+    bus.failNext(1);
+    TEST_ASSERT_NOT_EQUAL(0, sensor.setResolution(12));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[1]);   // ERROR_INIT_WRITE
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(12));
+
+    // with a valid shadow copy, only the write back is on the bus
+    bus.failNext(1);
+    TEST_ASSERT_NOT_EQUAL(0, sensor.setResolution(13));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[3]);   // ERROR_INIT_WRITE_BACK
+    TEST_ASSERT_EQUAL_UINT32(2, stats.op[SI70_OP_CONFIG].failures);
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(14));
+
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[4]);   // ERROR_MEAS_START
+
+    device.setConversionTime(14, 3 * SI70_CONV_TIME_14BIT_US);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[5]);   // ERROR_MEAS_READ
+    TEST_ASSERT_TRUE(stats.pollRetries > 0);
+
+    // the sensor finishes the late conversion first
+    bus.waitUs(3 * SI70_CONV_TIME_14BIT_US);
+    device.setConversionTime(14, 100);
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    TEST_ASSERT_EQUAL_INT(SI70_ERROR_CRC, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[6]);   // ERROR_MEAS_CRC
+    TEST_ASSERT_EQUAL_UINT32(SI70_CRC_RETRIES, stats.crcRetries);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.op[SI70_OP_MEASURE].failures);
+
+    device.corruptNext(1);
+    unsigned char serial[8];
+    TEST_ASSERT_EQUAL_INT(-1, sensor.getSerial(serial));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors[7]);   // ERROR_IDENT
+    TEST_ASSERT_EQUAL_UINT32(1, stats.op[SI70_OP_IDENT].failures);
+}
+
+#else
+
+// the instrumentation alone is larger than the sensor object without it
+static_assert(sizeof(SI7050) < sizeof(SI7050Stats), "SI70_STATS not compiled out");
+
+void TestStats_disabled() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    char data[2];
+    bus.attach(device);
+
+    // the compiled out hooks keep the operations and their bus traffic
+    device.setTemperature(2247);
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+    uint32_t transfers = bus.getTransfers();
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(data));
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.calcTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(2, bus.getTransfers() - transfers);
+
+    device.corruptNext(SI70_CRC_RETRIES + 1);
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    TEST_ASSERT_EQUAL_INT(SI70_ERROR_CRC, sensor.measureTemperature(data));
+}
+
+#endif
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 stats latency buckets-0", TestStats_bucket, greentea_failure_handler),
+#ifdef SI70_STATS
+Case("SI7050 stats operations-0", TestStats_operations, greentea_failure_handler),
+Case("SI7050 stats errors-0", TestStats_errors, greentea_failure_handler),
+#else
+Case("SI7050 stats compiled out-0", TestStats_disabled, greentea_failure_handler),
+#endif
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -57,7 +57,34 @@ void TestSi_calcTemperature() {
     data[0] = 100;
     data[1] = static_cast<char>(255);
     ret = sensor.calcTemperature(data);
-    TEST_ASSERT_UNLESS_MESSAGE(ret != 2247, "failed to calculate the temperature");
+    // the two lowest bits are not used with 14 bit resolution
+    TEST_ASSERT_UNLESS_MESSAGE(ret != 2246, "failed to calculate the temperature");
+}
+
+void TestSi_setResolution() {
+    int ret;
+    char data[2];
+    const int bits[] = {11, 12, 13, 14};
+
+    ret = sensor.setResolution(10);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, ret, "unsupported resolution accepted");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(14, sensor.getResolution(), "resolution changed by wrong setting");
+
+    for (int i = 0; i < 4; i++) {
+        ret = sensor.setResolution(bits[i]);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to set the resolution");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(bits[i], sensor.getResolution(), "wrong resolution");
+
+        ret = sensor.measureTemperature(data);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to measure with the resolution");
+    }
+
+    // 11 bit ignores the lowest 5 bits of the raw data
+    sensor.setResolution(11);
+    data[0] = 100;
+    data[1] = static_cast<char>(0xFF);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2239, sensor.calcTemperature(data), "wrong 11 bit calculation");
+    sensor.setResolution(14);
 }
 
 // test if the measurement fails if the data argument is not 2 byte
@@ -108,6 +135,52 @@ void TestSi_measureTemperature() {
     TEST_ASSERT_UNLESS_MESSAGE(delta_real > delta_2, "temperature difference bigger then +-2°C");
 }
 
+static volatile int callbackStatus;
+
+static void measurementDone(void *context, int status, const char *data) {
+    (void) context;
+    (void) data;
+    callbackStatus = status;
+}
+
+// test the split-phase measurement, which reports not ready during the conversion
+void TestSi_splitPhaseMeasurement() {
+    int ret;
+    char data[2];
+
+    ret = sensor.pollResult(data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, ret, "polled without a started measurement");
+
+    ret = sensor.startMeasurement();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to start the measurement");
+    ret = sensor.pollResult(data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(SI70_NOT_READY, ret, "result ready without conversion time");
+
+    do {
+        ret = sensor.pollResult(data);
+    } while (ret == SI70_NOT_READY);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to read the measurement");
+    TEST_ASSERT_FALSE_MESSAGE(sensor.isMeasuring(), "measurement still pending");
+
+    callbackStatus = 1;
+    ret = sensor.startMeasurement(measurementDone);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to start the measurement with callback");
+    while (sensor.pollResult() == SI70_NOT_READY) {
+        wait_ms(1);
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, callbackStatus, "callback was not called with success");
+}
+
+void TestSi_measureWithCRC() {
+    int ret;
+    char data[2];
+
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    ret = sensor.measureTemperature(data);
+    sensor.setIntegrityMode(SI70_INTEGRITY_NONE);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, ret, "failed to measure the temperature with CRC");
+}
+
 void TestSi_getFirmwareVersion() {
     int ret;
     ret = sensor.getFirmwareVersion();
@@ -186,7 +259,10 @@ Case("SI7050 reset-0", TestSi_reset, greentea_failure_handler),
 Case("SI7050 initialize-0", TestSi_initialize, greentea_failure_handler),
 Case("SI7050 get temperature-0", TestSi_getTemperature, greentea_failure_handler),
 Case("SI7050 calculate temperature-0", TestSi_calcTemperature, greentea_failure_handler),
+Case("SI7050 set resolution-0", TestSi_setResolution, greentea_failure_handler),
 Case("SI7050 measure temperature-0", TestSi_measureTemperature, greentea_failure_handler),
+Case("SI7050 split-phase measurement-0", TestSi_splitPhaseMeasurement, greentea_failure_handler),
+Case("SI7050 measure temperature with CRC-0", TestSi_measureWithCRC, greentea_failure_handler),
 Case("SI7050 get firmware version-0", TestSi_getFirmwareVersion, greentea_failure_handler),
 Case("SI7050 get ID-0", TestSi_getID, greentea_failure_handler),
 Case("SI7050 check calculation range min to max-0", TestSi_calculationRange, greentea_failure_handler),
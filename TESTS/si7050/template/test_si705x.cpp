@@ -0,0 +1,125 @@
+/*
+ * Si705x driver template tests against the simulated sensor.
+ *
+ * These tests do not need the real sensor and also run on the host,
+ * see host/CMakeLists.txt.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "Si705x.h"
+#include "SimSi7050.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+typedef Si705x<SimI2CBus, 11> Si705x11;
+typedef Si705x<SimI2CBus, 12> Si705x12;
+typedef Si705x<SimI2CBus, 14> Si705x14;
+typedef Si705x<SimI2CBus, 14, Si705xMilliCelsius> Si705x14Milli;
+
+// the constants are available at compile time
+static_assert(Si705x<SimI2CBus, 11>::conversionUs == SI70_CONV_TIME_11BIT_US, "wrong 11 bit conversion time");
+static_assert(Si705x<SimI2CBus, 14>::mask == SI70_MASK_14BIT, "wrong 14 bit mask");
+static_assert(Si705x<SimI2CBus>::convert(0x64FF) == 2246, "wrong compile-time conversion");
+static_assert(Si705x<SimI2CBus, 14, Si705xMilliCelsius>::convert(0) == -46850, "wrong milli degree conversion");
+
+template<int BITS>
+void testResolution() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    Si705x<SimI2CBus, BITS> sensor(bus);
+    uint16_t raw;
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.initialize(), "failed to initialize the sensor");
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(Si705xResolution<BITS>::userRegister, device.getUserRegister() & SI70_RES_MASK,
+                                   "resolution not written");
+
+    device.setRawTemperature(0x64FF);
+    uint32_t start = bus.readUs();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, sensor.measure(&raw), "failed to measure");
+    TEST_ASSERT_MESSAGE(bus.readUs() - start >= Si705xResolution<BITS>::conversionUs, "conversion time too short");
+    TEST_ASSERT_EQUAL_UINT32(0x64FF & Si705xResolution<BITS>::mask, raw);
+    TEST_ASSERT_EQUAL_INT(Si705xCentiCelsius::fromRaw(raw), sensor.getTemperature());
+}
+
+void TestSi705x_resolutions() {
+    testResolution<11>();
+    testResolution<12>();
+    testResolution<13>();
+    testResolution<14>();
+}
+
+void TestSi705x_lookup() {
+    for (uint32_t raw = 0; raw < 65536; raw++) {
+        TEST_ASSERT_EQUAL_INT(Si705x11::convert((uint16_t) raw), Si705x11::lookup((uint16_t) raw));
+        TEST_ASSERT_EQUAL_INT(Si705x12::convert((uint16_t) raw), Si705x12::lookup((uint16_t) raw));
+    }
+}
+
+void TestSi705x_units() {
+    for (uint32_t raw = 0; raw < 65536; raw += 4) {
+        int32_t milli = Si705x14Milli::convert((uint16_t) raw);
+        int32_t centi = Si705x14::convert((uint16_t) raw);
+        TEST_ASSERT_INT_WITHIN(10, centi * 10, milli);
+    }
+}
+
+void TestSi705x_identification() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    Si705x<SimI2CBus> sensor(bus);
+    char data[16];
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(SIM_SI70_FW_VERSION, sensor.readFirmwareVersion());
+    TEST_ASSERT_EQUAL_INT(0, sensor.readSerialRaw(data));
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(0x32, data[8], "wrong sensor detected");
+
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.readFirmwareVersion());
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(Si705xCentiCelsius::error, sensor.getTemperature());
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("Si705x resolutions-0", TestSi705x_resolutions, greentea_failure_handler),
+Case("Si705x lookup table-0", TestSi705x_lookup, greentea_failure_handler),
+Case("Si705x output units-0", TestSi705x_units, greentea_failure_handler),
+Case("Si705x identification-0", TestSi705x_identification, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
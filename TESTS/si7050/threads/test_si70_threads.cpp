@@ -0,0 +1,324 @@
+/*
+ * SI7050 Sensor library tests of the shared bus access and the
+ * latest sample cache from several threads.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <string.h>
+
+#include "SI7050.h"
+#include "SI7050Group.h"
+#include "SI7050Mux.h"
+#include "SimSi7050.h"
+#include "SimTca9548a.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#ifdef __MBED__
+#include "rtos.h"
+#else
+#include <thread>
+#endif
+
+using namespace utest::v1;
+
+#define THREADS         4
+#define THREAD_CALLS    50
+
+/*
+ * Run a function in THREADS threads and wait for all of them.
+ */
+static void runThreads(void (*function)(void *), void *args[THREADS]) {
+#ifdef __MBED__
+    rtos::Thread threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        threads[i].start(callback(function, args[i]));
+    }
+    for (int i = 0; i < THREADS; i++) {
+        threads[i].join();
+    }
+#else
+    std::thread threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        threads[i] = std::thread(function, args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        threads[i].join();
+    }
+#endif
+}
+
+/*
+ * Bus, which counts the transfers outside of a locked sequence.
+ */
+class LockCheckBus : public SimI2CBus {
+public:
+    LockCheckBus() : depth(0), unlockedTransfers(0) {}
+
+    virtual void lock() {
+        SimI2CBus::lock();
+        depth++;
+    }
+
+    virtual void unlock() {
+        depth--;
+        SimI2CBus::unlock();
+    }
+
+    virtual int write(int address, const char *data, int length, bool repeated) {
+        if (depth == 0) unlockedTransfers++;
+        return SimI2CBus::write(address, data, length, repeated);
+    }
+
+    virtual int read(int address, char *data, int length, bool repeated) {
+        if (depth == 0) unlockedTransfers++;
+        return SimI2CBus::read(address, data, length, repeated);
+    }
+
+    int depth;
+    int unlockedTransfers;
+};
+
+void TestThreads_lockedSequences() {
+    LockCheckBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+    TEST_ASSERT_EQUAL_INT(0, sensor.refreshDescriptor());
+    TEST_ASSERT_EQUAL_INT(0, sensor.setResolution(12));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, bus.unlockedTransfers, "transfer sequence not locked");
+    TEST_ASSERT_EQUAL_INT(0, bus.depth);
+}
+
+void TestThreads_latestSample() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    SI7050Sample sample;
+    char data[2];
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(-1, sensor.getLatestSample(&sample), "sample without measurement");
+
+    device.setTemperature(2247);
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature());
+    TEST_ASSERT_EQUAL_INT(0, sensor.getLatestSample(&sample));
+    TEST_ASSERT_EQUAL_INT(SI70_SAMPLE_OK, sample.status);
+    data[0] = (char) (sample.raw >> 8);
+    data[1] = (char) sample.raw;
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.calcTemperature(data));
+
+    // a fresh sample is served without bus transfer
+    device.setTemperature(3000);
+    uint32_t transfers = bus.getTransfers();
+    TEST_ASSERT_INT_WITHIN(1, 2247, sensor.getTemperature(1000000));
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(transfers, bus.getTransfers(), "cached sample not used");
+
+    // an old sample is measured again
+    bus.waitUs(1000001);
+    TEST_ASSERT_INT_WITHIN(1, 3000, sensor.getTemperature(1000000));
+    TEST_ASSERT_EQUAL_UINT32(2, device.getConversions());
+}
+
+struct ReaderArgs {
+    SI7050 *sensor;
+    int errors;
+};
+
+static void reader(void *arg) {
+    ReaderArgs *args = (ReaderArgs *) arg;
+
+    for (int i = 0; i < THREAD_CALLS; i++) {
+        int temperature = args->sensor->getTemperature(SI70_CONV_TIME_14BIT_US * 4);
+        if (temperature < 2146 || temperature > 2348) {
+            args->errors++;
+        }
+        args->sensor->getBus().waitUs(SI70_CONV_TIME_14BIT_US);
+    }
+}
+
+void TestThreads_concurrentReaders() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    ReaderArgs readers[THREADS];
+    void *args[THREADS];
+    bus.attach(device);
+
+    device.setTemperature(2247);
+    for (int i = 0; i < THREADS; i++) {
+        readers[i].sensor = &sensor;
+        readers[i].errors = 0;
+        args[i] = &readers[i];
+    }
+
+    runThreads(reader, args);
+
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, readers[i].errors, "wrong temperature from concurrent reader");
+    }
+    TEST_ASSERT_FALSE(sensor.isMeasuring());
+    TEST_ASSERT_TRUE_MESSAGE(device.getConversions() < THREADS * THREAD_CALLS, "readers did not share measurements");
+}
+
+struct MuxArgs {
+    SI7050Bus *bus;
+    TCA9548A *mux;
+    SI7050 *sensor;
+    int channel;
+    const unsigned char *serial;
+    int errors;
+};
+
+static void muxReader(void *arg) {
+    MuxArgs *args = (MuxArgs *) arg;
+
+    for (int i = 0; i < THREAD_CALLS; i++) {
+        SI7050ScopedLock<SI7050> sensorLock(*args->sensor);
+        SI7050ScopedLock<SI7050Bus> lock(*args->bus);
+
+        if (args->mux->select(args->channel) || args->sensor->refreshDescriptor() ||
+            memcmp(args->sensor->getDescriptor().serial, args->serial, 8) != 0) {
+            args->errors++;
+        }
+    }
+}
+
+void TestThreads_sharedMux() {
+    SimI2CBus bus;
+    SimTca9548a simMux;
+    SimSi7050 device[THREADS];
+    TCA9548A mux(bus);
+    SI7050 sensor0(bus), sensor1(bus), sensor2(bus), sensor3(bus);
+    SI7050 *sensors[THREADS] = {&sensor0, &sensor1, &sensor2, &sensor3};
+    unsigned char serials[THREADS][8];
+    MuxArgs readers[THREADS];
+    void *args[THREADS];
+
+    bus.attach(simMux);
+    for (int i = 0; i < THREADS; i++) {
+        // the serial of each sensor differs in SNA_0, the CRC is calculated by the model
+        const unsigned char serial[8] = {0x00, 0x16, 0x4b, (unsigned char) (0xe0 + i), 0x32, 0xff, 0xff, 0xff};
+        memcpy(serials[i], serial, 8);
+        device[i].setSerial(serial);
+        simMux.attach(i, device[i]);
+
+        readers[i].bus = &bus;
+        readers[i].mux = &mux;
+        readers[i].sensor = sensors[i];
+        readers[i].channel = i;
+        readers[i].serial = serials[i];
+        readers[i].errors = 0;
+        args[i] = &readers[i];
+    }
+
+    runThreads(muxReader, args);
+
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, readers[i].errors, "sequence interleaved on the shared bus");
+    }
+}
+
+struct GroupArgs {
+    SI7050Group *group;     // sweeps the group, if set
+    TCA9548A *mux;
+    SI7050 *sensor;
+    int channel;
+    int errors;
+};
+
+static void groupWorker(void *arg) {
+    GroupArgs *args = (GroupArgs *) arg;
+    int temperatures[2];
+
+    for (int i = 0; i < THREAD_CALLS; i++) {
+        if (args->group != NULL) {
+            if (args->group->sweep(temperatures)) {
+                args->errors++;
+            }
+            continue;
+        }
+
+        SI7050ScopedLock<SI7050> sensorLock(*args->sensor);
+        SI7050ScopedLock<SI7050Bus> lock(args->sensor->getBus());
+        if (args->mux->select(args->channel) || args->sensor->refreshDescriptor()) {
+            args->errors++;
+        }
+    }
+}
+
+void TestThreads_groupedSensor() {
+    SimI2CBus bus;
+    SimTca9548a simMux;
+    SimSi7050 device[2];
+    TCA9548A mux(bus);
+    SI7050 sensor0(bus), sensor1(bus);
+    SI7050Group group;
+    GroupArgs workers[THREADS];
+    void *args[THREADS];
+
+    bus.attach(simMux);
+    simMux.attach(0, device[0]);
+    simMux.attach(1, device[1]);
+    TEST_ASSERT_EQUAL_INT(0, group.add(sensor0, &mux, 0));
+    TEST_ASSERT_EQUAL_INT(0, group.add(sensor1, &mux, 1));
+
+    // one thread sweeps the group, the others use its sensors directly
+    for (int i = 0; i < THREADS; i++) {
+        workers[i].group = (i == 0) ? &group : NULL;
+        workers[i].mux = &mux;
+        workers[i].sensor = (i & 1) ? &sensor1 : &sensor0;
+        workers[i].channel = i & 1;
+        workers[i].errors = 0;
+        args[i] = &workers[i];
+    }
+    runThreads(groupWorker, args);
+
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, workers[i].errors, "grouped sensor failed");
+    }
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 threads locked sequences-0", TestThreads_lockedSequences, greentea_failure_handler),
+Case("SI7050 threads latest sample-0", TestThreads_latestSample, greentea_failure_handler),
+Case("SI7050 threads concurrent readers-0", TestThreads_concurrentReaders, greentea_failure_handler),
+Case("SI7050 threads shared mux-0", TestThreads_sharedMux, greentea_failure_handler),
+Case("SI7050 threads grouped sensor-0", TestThreads_groupedSensor, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,212 @@
+/*
+ * SI7050 Sensor library tests of the transaction trace and its replay.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Trace.h"
+#include "SimReplayBus.h"
+#include "SimSi7050.h"
+
+#ifndef __MBED__
+#include <chrono>
+#endif
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+static const unsigned char serial[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+
+/*
+ * Record initialize(), measureTemperature() and getSerial() on the
+ * simulated sensor.
+ */
+static size_t recordSession(uint8_t *trace, size_t size, int *temperature, uint32_t *busTime) {
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050TraceBus traceBus(bus, trace, size);
+    SI7050 sensor(traceBus);
+    unsigned char id[8];
+    bus.attach(device);
+    device.setSerial(serial);
+    device.setTemperature(2345);
+
+    sensor.initialize();
+    *temperature = sensor.getTemperature();
+    sensor.getSerial(id);
+    *busTime = bus.readUs();
+    return traceBus.getLength();
+}
+
+void TestTrace_record() {
+    SimI2CBus bus;
+    SimSi7050 device;
+    uint8_t trace[256];
+    SI7050TraceBus traceBus(bus, trace, sizeof(trace));
+    SI7050 sensor(traceBus);
+    SI7050TraceRecord record;
+    char data[2];
+    bus.attach(device);
+
+    TEST_ASSERT_EQUAL_INT(0, sensor.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(2, traceBus.getRecords());
+
+    // command, then the result
+    SI7050TraceReader reader(trace, traceBus.getLength());
+    TEST_ASSERT_EQUAL_INT(0, reader.next(&record));
+    TEST_ASSERT_EQUAL_HEX8(0, record.flags);
+    TEST_ASSERT_EQUAL_HEX8(SI70_ADDRESS, record.address);
+    TEST_ASSERT_EQUAL_INT(1, record.length);
+    TEST_ASSERT_EQUAL_HEX8(0xF3, record.data[0]);
+    TEST_ASSERT_TRUE(record.duration > 0);
+
+    // the conversion time passes before the read
+    uint32_t commandEnd = record.timestamp + record.duration;
+    TEST_ASSERT_EQUAL_INT(0, reader.next(&record));
+    TEST_ASSERT_EQUAL_HEX8(SI70_TRACE_READ, record.flags);
+    TEST_ASSERT_EQUAL_INT(2, record.length);
+    TEST_ASSERT_EQUAL_HEX8(data[0], record.data[0]);
+    TEST_ASSERT_EQUAL_HEX8(data[1], record.data[1]);
+    TEST_ASSERT_TRUE(record.timestamp - commandEnd >= SI70_CONV_TIME_14BIT_US);
+    TEST_ASSERT_EQUAL_INT(1, reader.next(&record));
+
+    // a failed read has no data
+    traceBus.clear();
+    bus.failNext(1);
+    TEST_ASSERT_EQUAL_INT(-1, sensor.measureTemperature(data));
+    SI7050TraceReader failed(trace, traceBus.getLength());
+    TEST_ASSERT_EQUAL_INT(0, failed.next(&record));
+    TEST_ASSERT_EQUAL_HEX8(SI70_TRACE_NACK, record.flags);
+
+    // a full buffer drops the records, the bus still works
+    uint8_t small[8];
+    SI7050TraceBus smallBus(bus, small, sizeof(small));
+    SI7050 other(smallBus);
+    TEST_ASSERT_EQUAL_INT(0, other.measureTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(0, smallBus.getRecords());
+    TEST_ASSERT_TRUE(smallBus.getDropped() > 0);
+}
+
+void TestTrace_replay() {
+    uint8_t trace[512];
+    int temperature;
+    uint32_t busTime;
+    size_t length = recordSession(trace, sizeof(trace), &temperature, &busTime);
+
+    // the same sequence against the trace, without the sensor
+    SimReplayBus bus(trace, length);
+    SI7050 sensor(bus);
+    unsigned char id[8];
+    TEST_ASSERT_EQUAL_INT(0, sensor.initialize());
+    TEST_ASSERT_EQUAL_INT(temperature, sensor.getTemperature());
+    TEST_ASSERT_EQUAL_INT(0, sensor.getSerial(id));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(serial, id, 8);
+
+    TEST_ASSERT_TRUE(bus.isDone());
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getMismatches());
+    TEST_ASSERT_EQUAL_INT(-1, bus.getFirstMismatch());
+    // the replay has the timing of the recording
+    TEST_ASSERT_EQUAL_UINT32(busTime, bus.readUs());
+}
+
+void TestTrace_regression() {
+    uint8_t trace[512], changed[512];
+    int temperature;
+    uint32_t busTime;
+    size_t length = recordSession(trace, sizeof(trace), &temperature, &busTime);
+
+    // other traffic: a different resolution
+    SimReplayBus bus(trace, length);
+    SI7050 sensor(bus);
+    sensor.initialize();
+    TEST_ASSERT_EQUAL_INT(-1, sensor.setResolution(12));
+    TEST_ASSERT_EQUAL_UINT32(1, bus.getMismatches());
+    int index = bus.getFirstMismatch();
+    TEST_ASSERT_TRUE(index > 0);
+
+    // the comparison of two traces finds the same transaction
+    SimI2CBus simBus;
+    SimSi7050 device;
+    SI7050TraceBus traceBus(simBus, changed, sizeof(changed));
+    SI7050 other(traceBus);
+    simBus.attach(device);
+    device.setSerial(serial);
+    other.initialize();
+    other.setResolution(12);
+    TEST_ASSERT_EQUAL_INT(index, SI7050TraceReader::compare(trace, length, changed, traceBus.getLength()));
+    TEST_ASSERT_EQUAL_INT(-1, SI7050TraceReader::compare(trace, length, trace, length));
+
+    // broken traces
+    SI7050TraceRecord record;
+    SI7050TraceReader truncated(trace, 5);
+    TEST_ASSERT_EQUAL_INT(-1, truncated.next(&record));
+}
+
+// wall time in us
+static uint32_t nowUs() {
+#ifdef __MBED__
+    return us_ticker_read();
+#else
+    return (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void TestTrace_realTime() {
+    uint8_t trace[512];
+    int temperature;
+    uint32_t busTime;
+    size_t length = recordSession(trace, sizeof(trace), &temperature, &busTime);
+
+    SimReplayBus bus(trace, length, true);
+    SI7050 sensor(bus);
+    uint32_t start = nowUs();
+    sensor.initialize();
+    TEST_ASSERT_EQUAL_INT(temperature, sensor.getTemperature());
+    uint32_t elapsed = nowUs() - start;
+
+    // sleeps at least the recorded conversion time
+    TEST_ASSERT_TRUE(elapsed >= SI70_CONV_TIME_14BIT_US);
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getMismatches());
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 trace record-0", TestTrace_record, greentea_failure_handler),
+Case("SI7050 trace replay-0", TestTrace_replay, greentea_failure_handler),
+Case("SI7050 trace regression-0", TestTrace_regression, greentea_failure_handler),
+Case("SI7050 trace real time replay-0", TestTrace_realTime, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -0,0 +1,188 @@
+/*
+ * SI7050 Sensor library tests of the streaming window aggregates.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "SI7050Window.h"
+#include "Si705x.h"
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+using namespace utest::v1;
+
+#define SAMPLES 1000
+
+// the summary of samples[first .. first + n), computed by scanning
+static void reference(const uint16_t *samples, int n, SI7050Summary *summary) {
+    double sum = 0, squares = 0;
+    uint16_t lo = 0xFFFF, hi = 0;
+
+    for (int i = 0; i < n; i++) {
+        double t = 175.72 * samples[i] / 65536.0 - 46.85;
+        sum += t;
+        squares += t * t;
+        lo = samples[i] < lo ? samples[i] : lo;
+        hi = samples[i] > hi ? samples[i] : hi;
+    }
+    double mean = sum / n;
+    summary->count = n;
+    summary->min = Si705xCentiCelsius::fromRaw(lo);
+    summary->max = Si705xCentiCelsius::fromRaw(hi);
+    summary->mean = (int16_t) floor(mean * 100);
+    summary->stddev = (uint16_t) lround(sqrt(squares / n - mean * mean) * 100);
+}
+
+static void assertSummary(const SI7050Summary &expected, const SI7050Summary &actual) {
+    TEST_ASSERT_EQUAL_UINT32(expected.count, actual.count);
+    TEST_ASSERT_EQUAL_INT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_INT(expected.max, actual.max);
+    TEST_ASSERT_INT_WITHIN(1, expected.mean, actual.mean);
+    TEST_ASSERT_INT_WITHIN(1, expected.stddev, actual.stddev);
+}
+
+static void makeSamples(uint16_t *samples) {
+    int32_t raw = 0x6800;
+
+    srand(7);
+    for (int i = 0; i < SAMPLES; i++) {
+        raw += (rand() % 41 - 20) * 4;
+        raw = raw < 0x1000 ? 0x1000 : raw > 0xF000 ? 0xF000 : raw;
+        samples[i] = (uint16_t) raw;
+    }
+}
+
+void TestWindow_tumbling() {
+    uint16_t samples[SAMPLES];
+    SI7050TumblingWindow short_(10), long_(60), all(SAMPLES);
+    SI7050Summary summary, expected;
+    int shortCount = 0, longCount = 0;
+    makeSamples(samples);
+
+    TEST_ASSERT_FALSE(short_.peek(&summary));
+    for (int i = 0; i < SAMPLES; i++) {
+        // several window lengths on the same samples
+        if (short_.update(samples[i], &summary)) {
+            reference(&samples[i - 9], 10, &expected);
+            assertSummary(expected, summary);
+            shortCount++;
+        }
+        if (long_.update(samples[i], &summary)) {
+            reference(&samples[i - 59], 60, &expected);
+            assertSummary(expected, summary);
+            longCount++;
+        }
+        if (all.update(samples[i], &summary)) {
+            TEST_ASSERT_EQUAL_INT(SAMPLES - 1, i);
+            reference(samples, SAMPLES, &expected);
+            assertSummary(expected, summary);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(SAMPLES / 10, shortCount);
+    TEST_ASSERT_EQUAL_INT(SAMPLES / 60, longCount);
+
+    // the incomplete window
+    TEST_ASSERT_TRUE(long_.peek(&summary));
+    reference(&samples[SAMPLES / 60 * 60], SAMPLES % 60, &expected);
+    assertSummary(expected, summary);
+    long_.reset();
+    TEST_ASSERT_FALSE(long_.peek(&summary));
+}
+
+void TestWindow_sliding() {
+    uint16_t samples[SAMPLES];
+    SI7050SlidingWindow<7> small;
+    SI7050SlidingWindow<100> large;
+    SI7050Summary summary, expected;
+    makeSamples(samples);
+
+    TEST_ASSERT_FALSE(small.get(&summary));
+    for (int i = 0; i < SAMPLES; i++) {
+        small.update(samples[i]);
+        large.update(samples[i]);
+
+        int n = i < 7 ? i + 1 : 7;
+        TEST_ASSERT_EQUAL_UINT32(n, small.size());
+        TEST_ASSERT_TRUE(small.get(&summary));
+        reference(&samples[i + 1 - n], n, &expected);
+        assertSummary(expected, summary);
+
+        n = i < 100 ? i + 1 : 100;
+        large.get(&summary);
+        reference(&samples[i + 1 - n], n, &expected);
+        assertSummary(expected, summary);
+    }
+
+    small.reset();
+    TEST_ASSERT_FALSE(small.get(&summary));
+    small.update(samples[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, small.size());
+}
+
+void TestWindow_limits() {
+    SI7050TumblingWindow window(SI70_WINDOW_MAX_LENGTH);
+    SI7050Summary summary;
+
+    // the exact sums of the longest window at the extreme codes
+    for (uint32_t i = 0; i < SI70_WINDOW_MAX_LENGTH; i++) {
+        if (window.update(i & 1 ? 0xFFFC : 0x0000, &summary)) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(SI70_WINDOW_MAX_LENGTH, summary.count);
+    TEST_ASSERT_EQUAL_INT(-4685, summary.min);
+    TEST_ASSERT_EQUAL_INT(Si705xCentiCelsius::fromRaw(0xFFFC), summary.max);
+    TEST_ASSERT_INT_WITHIN(1, (Si705xCentiCelsius::fromRaw(0xFFFC) - 4685) / 2, summary.mean);
+    TEST_ASSERT_INT_WITHIN(1, (Si705xCentiCelsius::fromRaw(0xFFFC) + 4685) / 2, summary.stddev);
+
+    // a constant input has no deviation
+    SI7050SlidingWindow<4> constant;
+    for (int i = 0; i < 10; i++) {
+        constant.update(0x6A00);
+    }
+    constant.get(&summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.stddev);
+    TEST_ASSERT_EQUAL_INT(Si705xCentiCelsius::fromRaw(0x6A00), summary.mean);
+}
+
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+Case("SI7050 window tumbling-0", TestWindow_tumbling, greentea_failure_handler),
+Case("SI7050 window sliding-0", TestWindow_sliding, greentea_failure_handler),
+Case("SI7050 window limits-0", TestWindow_limits, greentea_failure_handler),
+
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+
+int main() {
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    Harness::run(specification);
+}
@@ -1,3 +1,3 @@
 #! /bin/sh
-rm -r BUILD mbed-os.lib .mbed mbed_settings.py* testmem.csv testresult.xml
+rm -r BUILD mbed-os.lib .mbed mbed_settings.py* testmem.csv testresult.xml footprint.csv
 rm -fr mbed-os
\ No newline at end of file
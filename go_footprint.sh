@@ -0,0 +1,25 @@
+#! /bin/sh
+# Flash and RAM of the driver on the target per feature configuration.
+# Builds the sensor test for each configuration and exports the memory
+# map of the library with memap, like the memory metrics of go_runtests.sh.
+# The result is footprint.csv, the host variant is host/footprint.sh.
+TARGET=NRF52_DK
+TOOLCHAIN=GCC_ARM
+mbed new .
+mbed target $TARGET
+mbed toolchain $TOOLCHAIN
+
+echo "configuration,module,static_ram,total_flash" > footprint.csv
+printf '%s\n' \
+    "default:" \
+    "stats:-DSI70_STATS" \
+    "crc-nibble:-DSI70_CRC_NIBBLE_TABLE" \
+    "stats+crc-nibble:-DSI70_STATS -DSI70_CRC_NIBBLE_TABLE" |
+while IFS=: read -r name defines; do
+    BUILD=BUILD/footprint/$name
+    mbed compile --source mbed-os --source SI7050 --source TESTS/si7050/temp \
+        --build "$BUILD" $defines || exit 1
+    python mbed-os/tools/memap.py -t $TOOLCHAIN -d 2 -e csv-ci -o "$BUILD/memap.csv" "$BUILD"/*.map || exit 1
+    # keep the rows of the library and the totals
+    grep -E '^(SI7050|Total)' "$BUILD/memap.csv" | sed "s/^/$name,/" >> footprint.csv
+done
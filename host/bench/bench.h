@@ -0,0 +1,42 @@
+/*
+ * Helpers for the SI7050 host benchmarks.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+/** Measure the wall time of a benchmark loop in ns */
+template<typename F>
+double benchNs(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/** Keep the compiler from optimizing away a benchmark result */
+template<typename T>
+void benchKeep(const T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+#endif // HOST_BENCH_H
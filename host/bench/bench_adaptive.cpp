@@ -0,0 +1,149 @@
+/*
+ * Bus and sensor load of the adaptive sampler against the fixed rate: an
+ * hour of an enclosure temperature on the simulated sensor, with a heating
+ * ramp, a plateau and the cooling back, plus the noise of the sensor.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+
+#include "SI7050Alarm.h"
+#include "SI7050Sampler.h"
+#include "SI7050Trace.h"
+#include "SimSi7050.h"
+#include "bench.h"
+
+#define BENCH_PERIOD_US     1000000u
+#define BENCH_DURATION_S    3600
+#define BENCH_NOISE         3           // raw codes, about 0.01°C
+
+struct Run {
+    const char *name;
+    SI7050AdaptivePolicy policy;
+};
+
+struct Result {
+    uint32_t samples;
+    uint32_t baseline;
+    uint32_t transactions;
+    uint32_t conversions;
+    uint64_t convertingUs;      // the sensor is active
+    int maxErrorCenti;          // the last sample against the temperature, each second
+};
+
+struct Collector {
+    SI7050 *sensor;
+    uint32_t start;
+    uint32_t timestamps[BENCH_DURATION_S + 1];
+    int16_t values[BENCH_DURATION_S + 1];
+    uint64_t convertingUs;
+    int count;
+};
+
+/* the temperature of the enclosure in 0.01°C at the time s */
+static int profile(uint32_t s) {
+    if (s < 1200) return 2200;
+    if (s < 1500) return 2200 + (int) (s - 1200) * 800 / 300;   // heating
+    if (s < 2700) return 3000;
+    if (s < 3300) return 3000 - (int) (s - 2700) * 800 / 600;   // cooling
+    return 2200;
+}
+
+// smallest 14 bit raw code, which converts to at least a temperature in 0.01°C
+static uint16_t rawOf(int centiCelsius) {
+    return (uint16_t) SI7050Alarm::rawAtLeast(centiCelsius, SI70_MASK_14BIT);
+}
+
+static void collect(void *context, const SI7050Sample *sample) {
+    Collector *collector = (Collector *) context;
+
+    if (sample->status == SI70_SAMPLE_OK && collector->count <= BENCH_DURATION_S) {
+        collector->timestamps[collector->count] = sample->timestamp - collector->start;
+        collector->values[collector->count] = (int16_t) SI7050Convert::toCentiCelsius(sample->raw);
+        collector->count++;
+    }
+    collector->convertingUs += collector->sensor->getConversionTime();
+}
+
+static int run(const SI7050AdaptivePolicy &policy, Result *result) {
+    static Collector collector;
+    uint8_t trace[64];
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050TraceBus traceBus(bus, trace, sizeof(trace));
+    SI7050 sensor(traceBus);
+    SI7050Sampler sampler(sensor, BENCH_PERIOD_US, collect, &collector);
+    bus.attach(device);
+
+    collector.sensor = &sensor;
+    collector.count = 0;
+    collector.convertingUs = 0;
+    if (sampler.setAdaptivePolicy(policy) || sampler.start()) {
+        return -1;
+    }
+    collector.start = bus.readUs();
+
+    srand(1);
+    uint32_t now;
+    while ((now = bus.readUs() - collector.start) < BENCH_DURATION_S * 1000000u) {
+        int noise = rand() % (2 * BENCH_NOISE + 1) - BENCH_NOISE;
+        device.setRawTemperature((uint16_t) (rawOf(profile(now / 1000000)) + noise));
+        bus.waitUs(sampler.process());
+    }
+    sampler.stop();
+
+    // the application sees the last sample: its error against the temperature
+    int maxError = 0;
+    for (uint32_t s = 0, i = 0; s < BENCH_DURATION_S; s++) {
+        while (i + 1 < (uint32_t) collector.count && collector.timestamps[i + 1] <= s * 1000000u) i++;
+        int error = abs(collector.values[i] - profile(s));
+        if (error > maxError) maxError = error;
+    }
+
+    result->samples = sampler.getStats().samples;
+    result->baseline = sampler.getStats().baseline;
+    result->transactions = traceBus.getRecords() + traceBus.getDropped();
+    result->conversions = device.getConversions();
+    result->convertingUs = collector.convertingUs;
+    result->maxErrorCenti = maxError;
+    return 0;
+}
+
+int main() {
+    static const Run runs[] = {
+            {"fixed rate",           {0,  0, 0,                    0}},
+            {"adaptive",             {15, 4, 32 * BENCH_PERIOD_US, 0}},
+            {"adaptive, 11 bit",     {15, 4, 32 * BENCH_PERIOD_US, 11}},
+            {"adaptive, band 0.5°C", {50, 4, 32 * BENCH_PERIOD_US, 11}},
+    };
+    Result fixed = {};
+
+    printf("policy                samples  baseline  transactions  active [ms]  reduction  max error [0.01°C]\n");
+    for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        Result result;
+        if (run(runs[r].policy, &result)) {
+            printf("%s failed\n", runs[r].name);
+            return 1;
+        }
+        if (r == 0) fixed = result;
+        printf("%-21s %7u %9u %13u %12.0f %9.1fx %19d\n", runs[r].name, (unsigned) result.samples,
+               (unsigned) result.baseline, (unsigned) result.transactions, result.convertingUs / 1000.0,
+               (double) fixed.transactions / result.transactions, result.maxErrorCenti);
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Benchmark of the raw domain alarms (SI7050Alarm) against converting every
+ * sample and comparing the temperature with the same hysteresis.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+
+#include "SI7050Alarm.h"
+#include "Si705x.h"
+#include "bench.h"
+
+#define BENCH_SAMPLES   4096
+#define BENCH_ROUNDS    2000
+#define BENCH_ALARMS    4
+
+#define BENCH_HYSTERESIS 50
+
+static const int thresholds[BENCH_ALARMS] = {1800, 2000, 2200, 2400};
+
+int main() {
+    static uint16_t raws[BENCH_SAMPLES];
+    SI7050Alarm alarms;
+    uint32_t rawActive = 0, convertedActive = 0;
+
+    // a noisy random walk around room temperature, which crosses the thresholds
+    int32_t raw = 0x6800;
+    srand(1);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        raw += (rand() % 9 - 4) * 4;
+        raw = raw < 0x6400 ? 0x6400 : raw > 0x6C00 ? 0x6C00 : raw;
+        raws[i] = (uint16_t) raw;
+    }
+    for (int i = 0; i < BENCH_ALARMS; i++) {
+        alarms.add(thresholds[i], BENCH_HYSTERESIS, SI70_ALARM_ABOVE);
+    }
+
+    uint32_t active = 0;
+    double nsConverted = benchNs([&]() {
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            for (int i = 0; i < BENCH_SAMPLES; i++) {
+                int temperature = Si705xCentiCelsius::fromRaw(raws[i]);
+                uint32_t next = 0;
+                for (int a = 0; a < BENCH_ALARMS; a++) {
+                    int limit = (active >> a) & 1 ? thresholds[a] - BENCH_HYSTERESIS : thresholds[a];
+                    next |= (uint32_t) (temperature >= limit) << a;
+                }
+                active = next;
+                convertedActive += active;
+            }
+            benchKeep(convertedActive);
+        }
+    });
+    double nsRaw = benchNs([&]() {
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            for (int i = 0; i < BENCH_SAMPLES; i++) {
+                rawActive += alarms.update(raws[i]);
+            }
+            benchKeep(rawActive);
+        }
+    });
+    if (rawActive != convertedActive) {
+        printf("alarm mismatch: raw %u, converted %u\n", (unsigned) rawActive, (unsigned) convertedActive);
+        return 1;
+    }
+
+    double samples = (double) BENCH_SAMPLES * BENCH_ROUNDS;
+    printf("%d alarms            ns/sample\n", BENCH_ALARMS);
+    printf("convert + compare  %10.2f\n", nsConverted / samples);
+    printf("raw domain         %10.2f\n", nsRaw / samples);
+
+    return 0;
+}
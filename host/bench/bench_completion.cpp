@@ -0,0 +1,71 @@
+/*
+ * Latency of the completion strategies of measureTemperature() on the
+ * simulated sensor with conversion jitter (virtual time).
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <algorithm>
+#include <stdio.h>
+
+#include "SI7050.h"
+#include "SimSi7050.h"
+
+#define MEASUREMENTS    1000
+
+static int run(const char *name, int mode, uint32_t pollInterval) {
+    static uint32_t latency[MEASUREMENTS];
+    SimI2CBus bus;
+    SimSi7050 device;
+    SI7050 sensor(bus);
+    double sum = 0;
+    bus.attach(device);
+
+    // the typical conversion time is 60 % of the maximum, spread it up to the maximum
+    device.setConversionJitter(SI70_CONV_TIME_14BIT_US * 4 / 10);
+    sensor.setCompletionMode(mode, pollInterval);
+
+    uint32_t transfers = bus.getTransfers();
+    uint32_t bytes = bus.getBytes();
+    for (int i = 0; i < MEASUREMENTS; i++) {
+        uint32_t start = bus.readUs();
+        if (sensor.getTemperature() == -32768) {
+            printf("%s: measurement failed\n", name);
+            return 1;
+        }
+        latency[i] = bus.readUs() - start;
+        sum += latency[i];
+    }
+    transfers = bus.getTransfers() - transfers;
+    bytes = bus.getBytes() - bytes;
+
+    std::sort(latency, latency + MEASUREMENTS);
+    printf("%-12s %9.0f %9u %9u %9u %10.1f %8.1f\n", name, sum / MEASUREMENTS,
+           (unsigned) latency[MEASUREMENTS / 2], (unsigned) latency[MEASUREMENTS * 99 / 100],
+           (unsigned) latency[MEASUREMENTS - 1], (double) transfers / MEASUREMENTS, (double) bytes / MEASUREMENTS);
+
+    return 0;
+}
+
+int main() {
+    printf("strategy     mean [us]  p50 [us]  p99 [us]  max [us]  transfers    bytes\n");
+
+    return run("sleep", SI70_COMPLETION_SLEEP, 0)
+           || run("poll 250us", SI70_COMPLETION_POLL, 250)
+           || run("poll 500us", SI70_COMPLETION_POLL, 500)
+           || run("poll 1000us", SI70_COMPLETION_POLL, 1000)
+           || run("hold", SI70_COMPLETION_HOLD, 0);
+}
@@ -0,0 +1,81 @@
+/*
+ * Benchmark of the batched SI7050 conversion over all 65536 raw values.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Convert.h"
+#include "SimSi7050.h"
+#include "bench.h"
+
+#define RANGE   65536
+#define ROUNDS  200
+
+static uint8_t raw[2 * RANGE];
+static int16_t scalar[RANGE];
+static int16_t batch[RANGE];
+
+int main() {
+    SimI2CBus bus;
+    SI7050 sensor(bus);
+    uint32_t sum = 0;   // wraps, only kept from the optimizer
+
+    // the complete range of values, as in TestSi_calculationRange
+    for (int i = 0; i < RANGE; i++) {
+        raw[2 * i] = (uint8_t) (i >> 8);
+        raw[2 * i + 1] = (uint8_t) i;
+    }
+
+    double nsCalc = benchNs([&]() {
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < RANGE; i++) {
+                sum += (uint32_t) sensor.calcTemperature((const char *) &raw[2 * i]);
+            }
+            benchKeep(sum);
+        }
+    });
+    double nsScalar = benchNs([&]() {
+        for (int r = 0; r < ROUNDS; r++) {
+            SI7050Convert::convertScalar(raw, scalar, RANGE);
+            benchKeep(scalar);
+        }
+    });
+    double nsBatch = benchNs([&]() {
+        for (int r = 0; r < ROUNDS; r++) {
+            SI7050Convert::convert(raw, batch, RANGE);
+            benchKeep(batch);
+        }
+    });
+
+    for (int i = 0; i < RANGE; i++) {
+        int expect = sensor.calcTemperature((const char *) &raw[2 * i]);
+        if (scalar[i] != expect || batch[i] != expect) {
+            printf("mismatch at raw 0x%04x: calcTemperature %d, scalar %d, batch %d\n", i, expect, scalar[i],
+                   batch[i]);
+            return 1;
+        }
+    }
+
+    double samples = (double) RANGE * ROUNDS;
+    printf("conversion of all %d raw values (%d rounds)\n", RANGE, ROUNDS);
+    printf("calcTemperature()   %8.3f ns/sample\n", nsCalc / samples);
+    printf("scalar batch        %8.3f ns/sample\n", nsScalar / samples);
+    printf("%-6s batch         %8.3f ns/sample (%.1fx scalar)\n", SI7050Convert::path(), nsBatch / samples,
+           nsScalar / nsBatch);
+    printf("all results equal\n");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Benchmark of the SI7050 CRC-8 engine against the former bit-serial routine.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "SI7050Crc.h"
+#include "bench.h"
+
+#define BENCH_BYTES     4096
+#define BENCH_ROUNDS    2000
+
+// the former bit-serial implementation, which works on bit swapped data
+static unsigned char bitswap(unsigned char input) {
+    unsigned char output = 0;
+    for (int k = 0; k < 8; k++) {
+        output |= ((input >> k) & 0x01) << (7 - k);
+    }
+    return output;
+}
+
+static unsigned char crc8(const unsigned char *data, uint8_t len, unsigned char init) {
+    unsigned char crc = bitswap(init);
+
+    for (int i = 0; i < len; i++) {
+        unsigned char inbyte = bitswap(data[i]);
+        for (uint8_t j = 0; j < 8; j++) {
+            unsigned char mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return bitswap(crc);
+}
+
+static unsigned char crcBitSerial(const unsigned char *data, size_t len, unsigned char init) {
+    // the former routine takes at most 255 Bytes per call
+    while (len > 0) {
+        uint8_t chunk = (uint8_t) (len > 255 ? 255 : len);
+        init = crc8(data, chunk, init);
+        data += chunk;
+        len -= chunk;
+    }
+    return init;
+}
+
+typedef unsigned char (*CrcFunction)(const unsigned char *data, size_t len, unsigned char init);
+
+static double run(CrcFunction f, const unsigned char *data, size_t len, int rounds, unsigned char *result) {
+    unsigned char crc = 0;
+    double ns = benchNs([&]() {
+        for (int r = 0; r < rounds; r++) {
+            crc = f(data, len, crc);
+            benchKeep(crc);
+        }
+    });
+    *result = crc;
+    return ns / ((double) len * rounds);
+}
+
+int main() {
+    static unsigned char data[BENCH_BYTES];
+    unsigned char ref, table, nibble;
+
+    srand(1);
+    for (int i = 0; i < BENCH_BYTES; i++) {
+        data[i] = (unsigned char) rand();
+    }
+
+    double nsBit = run(crcBitSerial, data, BENCH_BYTES, BENCH_ROUNDS / 20, &ref);
+    double nsTable = run(SI7050Crc::calcTable, data, BENCH_BYTES, BENCH_ROUNDS / 20, &table);
+    double nsNibble = run(SI7050Crc::calcNibble, data, BENCH_BYTES, BENCH_ROUNDS / 20, &nibble);
+    if (ref != table || ref != nibble) {
+        printf("CRC mismatch: bit-serial 0x%02x, table 0x%02x, nibble 0x%02x\n", ref, table, nibble);
+        return 1;
+    }
+
+    // the per transaction case: 2 data Bytes of a measurement
+    double nsBit2 = run(crcBitSerial, data, 2, BENCH_ROUNDS * 100, &ref);
+    double nsTable2 = run(SI7050Crc::calcTable, data, 2, BENCH_ROUNDS * 100, &table);
+    double nsNibble2 = run(SI7050Crc::calcNibble, data, 2, BENCH_ROUNDS * 100, &nibble);
+
+    printf("CRC-8 (0x31)          ns/Byte (4 kB)   ns/Byte (2 Byte)\n");
+    printf("bit-serial + bitswap  %14.2f %18.2f\n", nsBit, nsBit2);
+    printf("256 Byte table        %14.2f %18.2f\n", nsTable, nsTable2);
+    printf("16 Byte nibble table  %14.2f %18.2f\n", nsNibble, nsNibble2);
+    printf("speedup table: %.1fx, nibble: %.1fx\n", nsBit / nsTable, nsBit / nsNibble);
+
+    return 0;
+}
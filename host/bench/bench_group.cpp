@@ -0,0 +1,67 @@
+/*
+ * Sweep time of the SI7050 group against serial measurements of N sensors
+ * behind a multiplexer, on the simulated bus (virtual time).
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdio.h>
+
+#include "SI7050Group.h"
+#include "SimSi7050.h"
+#include "SimTca9548a.h"
+
+int main() {
+    printf("sensors   serial [us]   group [us]   speedup\n");
+
+    for (int n = 1; n <= TCA9548A_CHANNELS; n++) {
+        SimI2CBus bus;
+        SimTca9548a simMux;
+        SimSi7050 devices[TCA9548A_CHANNELS];
+        TCA9548A mux(bus);
+        SI7050 *sensors[TCA9548A_CHANNELS];
+        SI7050Group group;
+        int temperatures[TCA9548A_CHANNELS];
+
+        bus.attach(simMux);
+        for (int i = 0; i < n; i++) {
+            simMux.attach(i, devices[i]);
+            devices[i].setConversionTime(14, SI70_CONV_TIME_14BIT_US);
+            sensors[i] = new SI7050(bus);
+            group.add(*sensors[i], &mux, i);
+        }
+
+        uint32_t start = bus.readUs();
+        for (int i = 0; i < n; i++) {
+            mux.select(i);
+            sensors[i]->getTemperature();
+        }
+        uint32_t serial = bus.readUs() - start;
+
+        if (group.sweep(temperatures)) {
+            printf("sweep failed\n");
+            return 1;
+        }
+        printf("%7d %13u %12u %8.1fx\n", n, (unsigned) serial, (unsigned) group.getSweepTime(),
+               (double) serial / group.getSweepTime());
+
+        for (int i = 0; i < n; i++) {
+            delete sensors[i];
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Benchmark of the compact block log format (SI7050Log): compression of a
+ * realistic temperature series and encode/decode throughput.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include <stdlib.h>
+
+#include "SI7050.h"
+#include "SI7050Log.h"
+#include "bench.h"
+
+#define BENCH_SAMPLES   100000
+#define BENCH_BLOCK     256
+#define BENCH_ROUNDS    20
+
+/*
+ * Slowly drifting room temperature with noise of a few codes, sampled
+ * every 100 ms with some jitter of the timer.
+ */
+static void makeSeries(uint32_t *timestamps, uint16_t *raws, int resolution) {
+    int shift = 16 - resolution;
+    int32_t raw = 0x6A00;
+    uint32_t t = 12345;
+
+    srand(1);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        if (rand() % 50 == 0) {
+            raw += (rand() % 2 ? 1 : -1) * (1 << shift);
+        }
+        timestamps[i] = t;
+        raws[i] = (uint16_t) (raw + (rand() % 5 - 2) * (1 << shift));
+        t += 100000 + rand() % 50 - 25;
+    }
+}
+
+static size_t encode(const uint32_t *timestamps, const uint16_t *raws, int resolution, uint8_t *out) {
+    static const unsigned char serial[8] = {0};
+    size_t len = 0;
+    int i = 0;
+
+    while (i < BENCH_SAMPLES) {
+        SI7050LogEncoder encoder(&out[len], BENCH_BLOCK, serial, resolution);
+        while (i < BENCH_SAMPLES && encoder.add(timestamps[i], raws[i]) == 0) {
+            i++;
+        }
+        len += encoder.finish();
+    }
+    return len;
+}
+
+static int decode(const uint8_t *data, size_t len, uint32_t *checksum) {
+    SI7050LogDecoder decoder(data, len);
+    uint32_t timestamp, sum = 0;
+    uint16_t raw;
+    int n = 0;
+
+    while (decoder.nextBlock() == SI70_LOG_OK) {
+        while (decoder.next(&timestamp, &raw)) {
+            sum += timestamp ^ raw;
+            n++;
+        }
+    }
+    *checksum = sum;
+    return n;
+}
+
+int main() {
+    static uint32_t timestamps[BENCH_SAMPLES];
+    static uint16_t raws[BENCH_SAMPLES];
+    static uint8_t log[BENCH_SAMPLES * SI70_LOG_MAX_SAMPLE];
+
+    printf("bits  Byte/sample  ratio (vs %u Byte SI7050Sample)  encode [ns/sample]  decode [ns/sample]\n",
+           (unsigned) sizeof(SI7050Sample));
+
+    for (int resolution = 11; resolution <= 14; resolution++) {
+        uint32_t checksum, expected = 0;
+        size_t len = 0;
+        int n = 0;
+
+        makeSeries(timestamps, raws, resolution);
+        for (int i = 0; i < BENCH_SAMPLES; i++) {
+            expected += timestamps[i] ^ raws[i];
+        }
+
+        double nsEncode = benchNs([&]() {
+            for (int r = 0; r < BENCH_ROUNDS; r++) {
+                len = encode(timestamps, raws, resolution, log);
+                benchKeep(log[len / 2]);
+            }
+        });
+        double nsDecode = benchNs([&]() {
+            for (int r = 0; r < BENCH_ROUNDS; r++) {
+                n = decode(log, len, &checksum);
+                benchKeep(checksum);
+            }
+        });
+        if (n != BENCH_SAMPLES || checksum != expected) {
+            printf("round trip failed: %d samples\n", n);
+            return 1;
+        }
+
+        double bytes = (double) len / BENCH_SAMPLES;
+        printf("%4d %12.2f %32.1fx %19.1f %19.1f\n", resolution, bytes, sizeof(SI7050Sample) / bytes,
+               nsEncode / ((double) BENCH_SAMPLES * BENCH_ROUNDS), nsDecode / ((double) BENCH_SAMPLES * BENCH_ROUNDS));
+    }
+
+    return 0;
+}
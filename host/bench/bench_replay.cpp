@@ -0,0 +1,104 @@
+/*
+ * Deterministic profile of the driver sequences from recorded traces: the
+ * bus traffic of each sequence and the host time of its replay.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#include "SI7050Trace.h"
+#include "SimReplayBus.h"
+#include "SimSi7050.h"
+#include "bench.h"
+
+#define BENCH_ROUNDS    20000
+
+enum Sequence {
+    SEQ_INITIALIZE,
+    SEQ_MEASURE,
+    SEQ_SERIAL,
+    SEQUENCES
+};
+
+static const char *names[SEQUENCES] = {"initialize()", "measureTemperature()", "getSerial()"};
+
+static int run(SI7050 &sensor, int sequence) {
+    char data[2];
+    unsigned char serial[8];
+
+    switch (sequence) {
+        case SEQ_INITIALIZE:
+            return sensor.initialize();
+        case SEQ_MEASURE:
+            return sensor.measureTemperature(data);
+        default:
+            return sensor.getSerial(serial);
+    }
+}
+
+/*
+ * Each sequence is recorded on a new sensor object: after initialize(),
+ * getSerial() is served from the descriptor without bus traffic.
+ */
+int main() {
+    static uint8_t traces[SEQUENCES][512];
+    size_t lengths[SEQUENCES];
+
+    printf("sequence               transactions  Bytes  bus [us]  replay [ns]\n");
+
+    for (int s = 0; s < SEQUENCES; s++) {
+        SimI2CBus bus;
+        SimSi7050 device;
+        SI7050TraceBus traceBus(bus, traces[s], sizeof(traces[s]));
+        SI7050 sensor(traceBus);
+        bus.attach(device);
+
+        uint32_t start = bus.readUs();
+        if (run(sensor, s)) {
+            printf("%s failed\n", names[s]);
+            return 1;
+        }
+        uint32_t busTime = bus.readUs() - start;
+        lengths[s] = traceBus.getLength();
+
+        // the traffic, as seen on the wire: address and data Bytes
+        SI7050TraceReader reader(traces[s], lengths[s]);
+        SI7050TraceRecord record;
+        int transactions = 0, bytes = 0;
+        while (reader.next(&record) == 0) {
+            transactions++;
+            bytes += 1 + (record.flags & SI70_TRACE_NACK ? 0 : record.length);
+        }
+
+        // replay the sequence at full speed, the setup of the replay is included
+        int mismatches = 0;
+        double ns = benchNs([&]() {
+            for (int r = 0; r < BENCH_ROUNDS; r++) {
+                SimReplayBus replay(traces[s], lengths[s]);
+                SI7050 replayed(replay);
+                run(replayed, s);
+                mismatches += replay.getMismatches();
+            }
+        });
+        if (mismatches) {
+            printf("%s: replay does not match the trace\n", names[s]);
+            return 1;
+        }
+        printf("%-22s %12d %6d %9u %12.0f\n", names[s], transactions, bytes, (unsigned) busTime,
+               ns / BENCH_ROUNDS);
+    }
+
+    return 0;
+}
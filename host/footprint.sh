@@ -0,0 +1,124 @@
+#! /bin/sh
+# Footprint of the SI7050 library per feature configuration.
+#
+# Links a small application (an SI7050 on a bus, which initializes the
+# sensor, reads the serial and measures with CRC check) for each
+# configuration with -ffunction-sections -fdata-sections -Wl,--gc-sections
+# and writes the flash (text + data) and RAM (data + bss), which each
+# library source keeps in the linked image, from the linker map and the
+# size of one SI7050 object as CSV:
+#
+#   configuration,file,text,data,bss,flash,ram
+#
+# Functions and tables, which the application does not use, are dropped
+# by the linker and not counted, unused sources report 0. Read-only data
+# with relocations (.data.rel.ro, e.g. vtables) is counted as text.
+#
+# usage: host/footprint.sh [output.csv]
+#
+# The compiler is selected by CXX, NM, CXXFLAGS, LDFLAGS and LIBS, e.g. for a Cortex-M4:
+#   CXX=arm-none-eabi-g++ NM=arm-none-eabi-nm CXXFLAGS="-mcpu=cortex-m4 -mthumb" \
+#   LDFLAGS="--specs=nosys.specs" LIBS= host/footprint.sh
+# Without mbed-os, the mbed specific parts (__MBED__) are not included,
+# use go_footprint.sh for the target build.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-footprint.csv}
+CXX=${CXX:-c++}
+NM=${NM:-nm}
+LIBS=${LIBS--lpthread}
+FLAGS="-std=c++14 -Os -ffunction-sections -fdata-sections -fno-exceptions -fno-rtti $CXXFLAGS"
+
+CONFIGURATIONS="default:
+stats:-DSI70_STATS
+crc-nibble:-DSI70_CRC_NIBBLE_TABLE
+stats+crc-nibble:-DSI70_STATS -DSI70_CRC_NIBBLE_TABLE"
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# the application: a bus, which always acknowledges, and the RAM of one sensor object
+cat > "$TMP/app.cpp" << 'EOF'
+#include "SI7050.h"
+
+class FootprintBus : public SI7050Bus {
+public:
+    virtual int write(int, const char *, int, bool) { return 0; }
+    virtual int read(int, char *data, int length, bool) {
+        for (int i = 0; i < length; i++) data[i] = 0;
+        return 0;
+    }
+    virtual void waitUs(uint32_t) {}
+    virtual uint32_t readUs() { return 0; }
+};
+
+unsigned char si7050_object[sizeof(SI7050)];
+
+int main() {
+    static FootprintBus bus;
+    static SI7050 sensor(bus);
+    unsigned char serial[8];
+
+    sensor.setIntegrityMode(SI70_INTEGRITY_CRC);
+    sensor.initialize();
+    sensor.getSerial(serial);
+    return sensor.getTemperature() + si7050_object[0];
+}
+EOF
+
+echo "configuration,file,text,data,bss,flash,ram" > "$OUT"
+echo "$CONFIGURATIONS" | while IFS=: read -r name defines; do
+    mkdir -p "$TMP/$name"
+    for source in "$ROOT"/SI7050/*.cpp; do
+        file=$(basename "$source" .cpp)
+        $CXX $FLAGS $defines -I"$ROOT/SI7050" -c "$source" -o "$TMP/$name/$file.o" || exit 1
+    done
+    $CXX $FLAGS $defines -I"$ROOT/SI7050" -c "$TMP/app.cpp" -o "$TMP/$name/app.o" || exit 1
+    $CXX $FLAGS $LDFLAGS -Wl,--gc-sections -Wl,-Map,"$TMP/$name/app.map" \
+        -o "$TMP/$name/app" "$TMP/$name/app.o" "$TMP/$name"/[A-Z]*.o $LIBS || exit 1
+
+    # input sections of the library objects in the map, a long section
+    # name is on a line of its own, its address and size on the next one
+    awk -v name="$name" -v dir="$TMP/$name/" '
+        function hex(s,    i, n) {
+            s = tolower(s)
+            sub(/^0x/, "", s)
+            for (i = 1; i <= length(s); i++) {
+                n = n * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+            }
+            return n
+        }
+        /^Discarded input sections/ { discarded = 1 }
+        /^Linker script and memory map/ { discarded = 0 }
+        discarded { next }
+        /^ (\.[^ ]+|COMMON)$/ { section = $1; next }
+        /^ (\.[^ ]+|COMMON) +0x/ { section = $1; $1 = ""; $0 = $0 }
+        /^ +0x[0-9a-f]+ +0x[0-9a-f]+ / && section != "" {
+            file = $3
+            if (index(file, dir) == 1 && file !~ /app\.o$/) {
+                sub(/.*\//, "", file)
+                sub(/\.o$/, "", file)
+                size = hex($2)
+                if (section ~ /^\.(text|rodata|data\.rel\.ro)/) text[file] += size
+                else if (section ~ /^\.(data|init_array|fini_array)/) data[file] += size
+                else if (section ~ /^\.bss/ || section == "COMMON") bss[file] += size
+                files[file] = 1
+            }
+        }
+        { section = "" }
+        END {
+            for (f in files) {
+                printf "%s,%s,%d,%d,%d,%d,%d\n", name, f, text[f], data[f], bss[f], text[f] + data[f], data[f] + bss[f]
+            }
+        }' "$TMP/$name/app.map" | sort > "$TMP/$name/files.csv"
+    cat "$TMP/$name/files.csv" >> "$OUT"
+    awk -F, -v name="$name" '
+        { t += $3; d += $4; b += $5 }
+        END { printf "%s,total,%d,%d,%d,%d,%d\n", name, t, d, b, t + d, d + b }' "$TMP/$name/files.csv" >> "$OUT"
+
+    # RAM of one sensor object
+    object=$($NM -S -t d "$TMP/$name/app.o" | awk '/si7050_object/ { print $2 + 0 }')
+    echo "$name,SI7050 object,0,0,$object,0,$object" >> "$OUT"
+done
+
+column -s, -t < "$OUT" 2>/dev/null || cat "$OUT"
@@ -0,0 +1,49 @@
+/*
+ * Minimal host replacement of the greentea client used by the tests.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#ifndef HOST_GREENTEA_TEST_ENV_H
+#define HOST_GREENTEA_TEST_ENV_H
+
+#include <stdlib.h>
+#include "utest/utest.h"
+
+#define GREENTEA_SETUP(timeout, host_test) ((void) (timeout), (void) (host_test))
+
+inline utest::v1::status_t greentea_case_failure_abort_handler(const utest::v1::Case *const source,
+                                                               const utest::v1::failure_t reason) {
+    (void) source;
+    (void) reason;
+    return utest::v1::STATUS_CONTINUE;
+}
+
+inline utest::v1::status_t greentea_test_setup_handler(const size_t number_of_cases) {
+    (void) number_of_cases;
+    return utest::v1::STATUS_CONTINUE;
+}
+
+inline void greentea_test_teardown_handler(const size_t passed, const size_t failed,
+                                           const utest::v1::failure_t failure) {
+    (void) failure;
+    printf("%u passed, %u failed\n", (unsigned) passed, (unsigned) failed);
+    if (failed) {
+        exit(1);
+    }
+}
+
+#endif // HOST_GREENTEA_TEST_ENV_H
@@ -0,0 +1,106 @@
+/*
+ * Minimal host replacement of the unity assertions used by the tests.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#ifndef HOST_UNITY_H
+#define HOST_UNITY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace unity_host {
+
+struct failure {
+};
+
+inline void fail(const char *file, int line, const char *message) {
+    printf("%s:%d: FAIL: %s\n", file, line, message ? message : "");
+    throw failure();
+}
+
+inline void check(bool condition, const char *file, int line, const char *message) {
+    if (!condition) {
+        fail(file, line, message);
+    }
+}
+
+inline void checkEqual(long long expected, long long actual, const char *file, int line, const char *message) {
+    if (expected != actual) {
+        printf("%s:%d: expected %lld, was %lld\n", file, line, expected, actual);
+        fail(file, line, message);
+    }
+}
+
+inline void checkWithin(long long delta, long long expected, long long actual, const char *file, int line,
+                        const char *message) {
+    if (actual < expected - delta || actual > expected + delta) {
+        printf("%s:%d: expected %lld +-%lld, was %lld\n", file, line, expected, delta, actual);
+        fail(file, line, message);
+    }
+}
+
+inline void checkLessOrEqual(long long threshold, long long actual, const char *file, int line,
+                             const char *message) {
+    if (actual > threshold) {
+        printf("%s:%d: expected <= %lld, was %lld\n", file, line, threshold, actual);
+        fail(file, line, message);
+    }
+}
+
+inline void checkMemory(const void *expected, const void *actual, size_t len, const char *file, int line,
+                        const char *message) {
+    if (memcmp(expected, actual, len) != 0) {
+        fail(file, line, message);
+    }
+}
+
+} // namespace unity_host
+
+#define TEST_FAIL_MESSAGE(m)                    unity_host::fail(__FILE__, __LINE__, (m))
+#define TEST_ASSERT_MESSAGE(c, m)               unity_host::check((c), __FILE__, __LINE__, (m))
+#define TEST_ASSERT(c)                          TEST_ASSERT_MESSAGE(c, #c)
+#define TEST_ASSERT_UNLESS_MESSAGE(c, m)        TEST_ASSERT_MESSAGE(!(c), m)
+#define TEST_ASSERT_TRUE_MESSAGE(c, m)          TEST_ASSERT_MESSAGE(c, m)
+#define TEST_ASSERT_FALSE_MESSAGE(c, m)         TEST_ASSERT_MESSAGE(!(c), m)
+#define TEST_ASSERT_TRUE(c)                     TEST_ASSERT_MESSAGE(c, #c)
+#define TEST_ASSERT_FALSE(c)                    TEST_ASSERT_MESSAGE(!(c), #c)
+#define TEST_ASSERT_EQUAL_MESSAGE(e, a, m)      \
+    unity_host::checkEqual((long long) (e), (long long) (a), __FILE__, __LINE__, (m))
+#define TEST_ASSERT_EQUAL_INT_MESSAGE(e, a, m)  TEST_ASSERT_EQUAL_MESSAGE(e, a, m)
+#define TEST_ASSERT_EQUAL_UINT32_MESSAGE(e, a, m) TEST_ASSERT_EQUAL_MESSAGE(e, a, m)
+#define TEST_ASSERT_EQUAL_HEX8_MESSAGE(e, a, m) \
+    TEST_ASSERT_EQUAL_MESSAGE((uint8_t) (e), (uint8_t) (a), m)
+#define TEST_ASSERT_EQUAL(e, a)                 TEST_ASSERT_EQUAL_MESSAGE(e, a, #a)
+#define TEST_ASSERT_EQUAL_INT(e, a)             TEST_ASSERT_EQUAL_MESSAGE(e, a, #a)
+#define TEST_ASSERT_NOT_EQUAL(e, a)             TEST_ASSERT_MESSAGE((long long) (e) != (long long) (a), #a)
+#define TEST_ASSERT_EQUAL_UINT16(e, a)          TEST_ASSERT_EQUAL_MESSAGE((uint16_t) (e), (uint16_t) (a), #a)
+#define TEST_ASSERT_EQUAL_UINT32(e, a)          TEST_ASSERT_EQUAL_MESSAGE(e, a, #a)
+#define TEST_ASSERT_EQUAL_HEX8(e, a)            TEST_ASSERT_EQUAL_HEX8_MESSAGE(e, a, #a)
+#define TEST_ASSERT_INT_WITHIN(d, e, a)         \
+    unity_host::checkWithin((long long) (d), (long long) (e), (long long) (a), __FILE__, __LINE__, #a)
+#define TEST_ASSERT_INT_WITHIN_MESSAGE(d, e, a, m) \
+    unity_host::checkWithin((long long) (d), (long long) (e), (long long) (a), __FILE__, __LINE__, (m))
+#define TEST_ASSERT_LESS_OR_EQUAL_UINT32(t, a) \
+    unity_host::checkLessOrEqual((long long) (t), (long long) (a), __FILE__, __LINE__, #a)
+#define TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(e, a, n, m) \
+    unity_host::checkMemory((e), (a), (n), __FILE__, __LINE__, (m))
+#define TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(e, a, n, m) TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(e, a, n, m)
+#define TEST_ASSERT_EQUAL_HEX8_ARRAY(e, a, n)   TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(e, a, n, #a)
+
+#endif // HOST_UNITY_H
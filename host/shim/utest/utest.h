@@ -0,0 +1,106 @@
+/*
+ * Minimal host replacement of the utest harness used by the tests.
+ *
+ * Copyright 2017 ubirch GmbH (https://ubirch.com)
+ *
+ * ```
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ```
+ */
+#ifndef HOST_UTEST_H
+#define HOST_UTEST_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "unity/unity.h"
+
+namespace utest {
+namespace v1 {
+
+enum status_t {
+    STATUS_CONTINUE = 0,
+    STATUS_ABORT = 1
+};
+
+struct failure_t {
+    int reason;
+};
+
+class Case;
+
+typedef status_t (*case_failure_handler_t)(const Case *const source, const failure_t reason);
+typedef status_t (*test_setup_handler_t)(const size_t number_of_cases);
+typedef void (*test_teardown_handler_t)(const size_t passed, const size_t failed, const failure_t failure);
+
+class Case
+{
+public:
+    Case(const char *description, void (*handler)(), case_failure_handler_t failure_handler = NULL)
+            : description(description), handler(handler), failure_handler(failure_handler) {}
+
+    const char *description;
+    void (*handler)();
+    case_failure_handler_t failure_handler;
+};
+
+class Specification
+{
+public:
+    template<size_t N>
+    Specification(test_setup_handler_t setup, const Case (&cases)[N], test_teardown_handler_t teardown)
+            : setup(setup), cases(cases), count(N), teardown(teardown) {}
+
+    test_setup_handler_t setup;
+    const Case *cases;
+    size_t count;
+    test_teardown_handler_t teardown;
+};
+
+class Harness
+{
+public:
+    static int failed;
+
+    static bool run(const Specification &specification) {
+        size_t passed = 0;
+        failure_t failure = {0};
+
+        if (specification.setup) {
+            specification.setup(specification.count);
+        }
+        for (size_t i = 0; i < specification.count; i++) {
+            const Case &c = specification.cases[i];
+            try {
+                c.handler();
+                printf("[PASS] %s\n", c.description);
+                passed++;
+            } catch (const unity_host::failure &) {
+                printf("[FAIL] %s\n", c.description);
+                failed++;
+                if (c.failure_handler) {
+                    failure_t reason = {1};
+                    c.failure_handler(&c, reason);
+                }
+            }
+        }
+        if (specification.teardown) {
+            specification.teardown(passed, failed, failure);
+        }
+        return failed == 0;
+    }
+};
+
+} // namespace v1
+} // namespace utest
+
+#endif // HOST_UTEST_H